@@ -29,7 +29,8 @@ OutputCellIterator::OutputCellIterator(const wchar_t& wch, const size_t fillLimi
     _attr(InvalidTextAttribute),
     _pos(0),
     _distance(0),
-    _fillLimit(fillLimit)
+    _fillLimit(fillLimit),
+    _end(fillLimit > 0 ? fillLimit : SIZE_MAX)
 {
 }
 
@@ -45,7 +46,8 @@ OutputCellIterator::OutputCellIterator(const TextAttribute& attr, const size_t f
     _attr(InvalidTextAttribute),
     _pos(0),
     _distance(0),
-    _fillLimit(fillLimit)
+    _fillLimit(fillLimit),
+    _end(fillLimit > 0 ? fillLimit : SIZE_MAX)
 {
 }
 
@@ -62,7 +64,8 @@ OutputCellIterator::OutputCellIterator(const wchar_t& wch, const TextAttribute&
     _attr(InvalidTextAttribute),
     _pos(0),
     _distance(0),
-    _fillLimit(fillLimit)
+    _fillLimit(fillLimit),
+    _end(fillLimit > 0 ? fillLimit : SIZE_MAX)
 {
 }
 
@@ -78,7 +81,8 @@ OutputCellIterator::OutputCellIterator(const CHAR_INFO& charInfo, const size_t f
     _attr(InvalidTextAttribute),
     _pos(0),
     _distance(0),
-    _fillLimit(fillLimit)
+    _fillLimit(fillLimit),
+    _end(fillLimit > 0 ? fillLimit : SIZE_MAX)
 {
 }
 
@@ -93,7 +97,8 @@ OutputCellIterator::OutputCellIterator(const std::wstring_view utf16Text) noexce
     _attr(InvalidTextAttribute),
     _pos(0),
     _distance(0),
-    _fillLimit(0)
+    _fillLimit(0),
+    _end(utf16Text.size())
 {
 }
 
@@ -109,7 +114,8 @@ OutputCellIterator::OutputCellIterator(const std::wstring_view utf16Text, const
     _attr(attribute),
     _distance(0),
     _pos(0),
-    _fillLimit(fillLimit)
+    _fillLimit(fillLimit),
+    _end(utf16Text.size())
 {
 }
 
@@ -124,7 +130,8 @@ OutputCellIterator::OutputCellIterator(const std::span<const WORD> legacyAttrs)
     _attr(InvalidTextAttribute),
     _distance(0),
     _pos(0),
-    _fillLimit(0)
+    _fillLimit(0),
+    _end(legacyAttrs.size())
 {
 }
 
@@ -139,7 +146,8 @@ OutputCellIterator::OutputCellIterator(const std::span<const CHAR_INFO> charInfo
     _attr(InvalidTextAttribute),
     _distance(0),
     _pos(0),
-    _fillLimit(0)
+    _fillLimit(0),
+    _end(charInfos.size())
 {
 }
 
@@ -154,7 +162,8 @@ OutputCellIterator::OutputCellIterator(const std::span<const OutputCell> cells)
     _attr(InvalidTextAttribute),
     _distance(0),
     _pos(0),
-    _fillLimit(0)
+    _fillLimit(0),
+    _end(cells.size())
 {
 }
 
@@ -164,42 +173,9 @@ OutputCellIterator::OutputCellIterator(const std::span<const OutputCell> cells)
 // - True if the views on dereference are valid. False if it shouldn't be dereferenced.
 OutputCellIterator::operator bool() const noexcept
 {
-    try
-    {
-        switch (_mode)
-        {
-        case Mode::Loose:
-        case Mode::LooseTextOnly:
-        {
-            // In lieu of using start and end, this custom iterator type simply becomes bool false
-            // when we run out of items to iterate over.
-            return _pos < std::get<std::wstring_view>(_run).length();
-        }
-        case Mode::Fill:
-        {
-            if (_fillLimit > 0)
-            {
-                return _pos < _fillLimit;
-            }
-            return true;
-        }
-        case Mode::Cell:
-        {
-            return _pos < std::get<std::span<const OutputCell>>(_run).size();
-        }
-        case Mode::CharInfo:
-        {
-            return _pos < std::get<std::span<const CHAR_INFO>>(_run).size();
-        }
-        case Mode::LegacyAttr:
-        {
-            return _pos < std::get<std::span<const WORD>>(_run).size();
-        }
-        default:
-            FAIL_FAST_HR(E_NOTIMPL);
-        }
-    }
-    CATCH_FAIL_FAST();
+    // In lieu of using start and end, this custom iterator type simply becomes bool false
+    // when we run out of items to iterate over. Infinite fills never advance _pos.
+    return _pos < _end;
 }
 
 size_t OutputCellIterator::Position() const noexcept
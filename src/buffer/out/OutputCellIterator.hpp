@@ -118,4 +118,7 @@ private:
     size_t _pos;
     size_t _distance;
     size_t _fillLimit;
+    // The _pos at which the iterator becomes invalid. Precomputed from the
+    // mode and run length, so that operator bool() doesn't need to branch.
+    size_t _end = 0;
 };
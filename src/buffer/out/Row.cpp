@@ -4,7 +4,9 @@
 #include "precomp.h"
 #include "Row.hpp"
 
+#include <bit>
 #include <isa_availability.h>
+#include <til/unicode.h>
 
 #include "../../types/inc/CodepointWidthDetector.hpp"
 
@@ -80,6 +82,93 @@ constexpr OutIt copy_n_small(InIt first, Diff count, OutIt dest)
     return dest;
 }
 
+#pragma warning(push)
+#pragma warning(disable : 26490) // Don't use reinterpret_cast (type.1).
+
+// Returns the width of characters that always form a grapheme cluster of their own, as long as they aren't followed
+// by something like a combining mark, and whose width doesn't depend on the TextMeasurementMode. Those are ASCII (1)
+// and the bulk of CJK text (2), see til::is_standalone_wide().
+// Returns 0 for anything else, which needs to be measured by CodepointWidthDetector.
+static constexpr int standaloneCharWidth(const wchar_t ch) noexcept
+{
+    if (ch < 0x80)
+    {
+        return 1;
+    }
+    if (til::is_standalone_wide(ch))
+    {
+        return 2;
+    }
+    return 0;
+}
+
+// Returns a pointer to the first character in [beg, end) that isn't a space, or `end` if there's none.
+// Rows are usually either mostly empty or mostly filled, so this checks 8 characters at a time.
+static const wchar_t* find_first_non_space(const wchar_t* beg, const wchar_t* end) noexcept
+{
+#if defined(TIL_SSE_INTRINSICS)
+    const auto spaces = _mm_set1_epi16(L' ');
+    for (; end - beg >= 8; beg += 8)
+    {
+        const auto vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(beg));
+        const auto mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi16(vec, spaces))) ^ 0xffff;
+        if (mask)
+        {
+            // Each wchar_t contributes 2 bits to the mask.
+            return beg + std::countr_zero(mask) / 2;
+        }
+    }
+#elif defined(TIL_ARM_NEON_INTRINSICS)
+    const auto spaces = vdupq_n_u16(L' ');
+    for (; end - beg >= 8; beg += 8)
+    {
+        if (vminvq_u16(vceqq_u16(vld1q_u16(reinterpret_cast<const uint16_t*>(beg)), spaces)) == 0)
+        {
+            break;
+        }
+    }
+#endif
+
+    for (; beg != end && *beg == L' '; ++beg)
+    {
+    }
+    return beg;
+}
+
+// Returns a pointer past the last character in [beg, end) that isn't a space, or `beg` if there's none.
+static const wchar_t* find_last_non_space(const wchar_t* beg, const wchar_t* end) noexcept
+{
+#if defined(TIL_SSE_INTRINSICS)
+    const auto spaces = _mm_set1_epi16(L' ');
+    for (; end - beg >= 8; end -= 8)
+    {
+        const auto vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(end - 8));
+        const auto mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_cmpeq_epi16(vec, spaces))) ^ 0xffff;
+        if (mask)
+        {
+            // The highest set bit belongs to the upper byte of the last non-space wchar_t.
+            return end - 8 + (std::bit_width(mask) + 1) / 2;
+        }
+    }
+#elif defined(TIL_ARM_NEON_INTRINSICS)
+    const auto spaces = vdupq_n_u16(L' ');
+    for (; end - beg >= 8; end -= 8)
+    {
+        if (vminvq_u16(vceqq_u16(vld1q_u16(reinterpret_cast<const uint16_t*>(end - 8)), spaces)) == 0)
+        {
+            break;
+        }
+    }
+#endif
+
+    for (; end != beg && end[-1] == L' '; --end)
+    {
+    }
+    return end;
+}
+
+#pragma warning(pop)
+
 CharToColumnMapper::CharToColumnMapper(const wchar_t* chars, const uint16_t* charOffsets, ptrdiff_t lastCharOffset, til::CoordType currentColumn) noexcept :
     _chars{ chars },
     _charOffsets{ charOffsets },
@@ -220,7 +309,9 @@ til::CoordType ROW::GetReadableColumnCount() const noexcept
 // - <none>
 void ROW::Reset(const TextAttribute& attr) noexcept
 {
-    _charsHeap.reset();
+    // _charsHeap is intentionally retained. Rows are recycled by IncrementCircularBuffer()
+    // and emoji/surrogate-heavy output would otherwise allocate and free it for every line.
+    // _resizeChars() picks it up again and Compact() frees it once the row has gone cold.
     _chars = { _charsBuffer, _columnCount };
     // Constructing and then moving objects into place isn't free.
     // Modifying the existing object is _much_ faster.
@@ -233,6 +324,53 @@ void ROW::Reset(const TextAttribute& attr) noexcept
     _init();
 }
 
+// Routine Description:
+// - Releases any spare capacity this row has accumulated while being written to.
+//   ReplaceCharacters() grows _charsHeap by 1.5x and _attr's run list doubles,
+//   which is great for rows that are actively being edited, but a waste of memory
+//   for rows that have scrolled into history and won't be touched again.
+// - If the text fits into _charsBuffer again it'll be moved back there,
+//   otherwise _charsHeap is reallocated to fit the text exactly.
+// - This is a no-op if an allocation fails, as all it does is saving memory.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void ROW::Compact() noexcept
+try
+{
+    if (_charsHeap && _chars.data() != _charsHeap.get())
+    {
+        // The heap buffer was retained by Reset() but isn't in use.
+        _charsHeap.reset();
+        _charsHeapCapacity = 0;
+    }
+    else if (_charsHeap)
+    {
+        const auto size = _charSize();
+
+        if (size <= _columnCount)
+        {
+            std::copy_n(_chars.begin(), size, _charsBuffer);
+            _charsHeap.reset();
+            _charsHeapCapacity = 0;
+            _chars = { _charsBuffer, _columnCount };
+        }
+        else if (size < _chars.size())
+        {
+            auto charsHeap = std::make_unique_for_overwrite<wchar_t[]>(size);
+            const std::span chars{ charsHeap.get(), size };
+            std::copy_n(_chars.begin(), size, chars.begin());
+            _charsHeap = std::move(charsHeap);
+            _charsHeapCapacity = gsl::narrow_cast<uint16_t>(size);
+            _chars = chars;
+        }
+    }
+
+    _attr.runs().shrink_to_fit();
+}
+CATCH_LOG()
+
 void ROW::_init() noexcept
 {
 #pragma warning(push)
@@ -433,6 +571,12 @@ OutputCellIterator ROW::WriteCells(OutputCellIterator it, const til::CoordType c
     auto colorStarts = gsl::narrow_cast<uint16_t>(columnBegin);
     auto currentIndex = colorStarts;
 
+    // The color runs are collected and committed into _attr all at once at the end. Calling
+    // _attr.replace() for each of them would cost O(runs) each, which adds up quickly for TUIs
+    // whose output alternates between many colors. replace() coalesces adjacent runs for us.
+    using ColorRun = decltype(_attr)::rle_type;
+    til::small_vector<ColorRun, 8> colorRuns;
+
     while (it && currentIndex <= finalColumnInRow)
     {
         // Fill the color if the behavior isn't set to keeping the current color.
@@ -447,8 +591,10 @@ OutputCellIterator ROW::WriteCells(OutputCellIterator it, const til::CoordType c
             else
             {
                 // Otherwise, commit this color into the run and save off the new one.
-                // Now commit the new color runs into the attr row.
-                _attr.replace(colorStarts, currentIndex, currentColor);
+                if (currentIndex != colorStarts)
+                {
+                    colorRuns.emplace_back(currentColor, gsl::narrow_cast<uint16_t>(currentIndex - colorStarts));
+                }
                 currentColor = it->TextAttr();
                 colorUses = 1;
                 colorStarts = currentIndex;
@@ -525,10 +671,16 @@ OutputCellIterator ROW::WriteCells(OutputCellIterator it, const til::CoordType c
         ++currentIndex;
     }
 
-    // Now commit the final color into the attr row
+    // Now commit the final color and all the runs before it into the attr row.
+    auto colorEnds = colorStarts;
     if (colorUses)
     {
-        _attr.replace(colorStarts, currentIndex, currentColor);
+        colorRuns.emplace_back(currentColor, gsl::narrow_cast<uint16_t>(currentIndex - colorStarts));
+        colorEnds = currentIndex;
+    }
+    if (!colorRuns.empty())
+    {
+        _attr.replace(gsl::narrow_cast<uint16_t>(columnBegin), colorEnds, std::span<const ColorRun>{ colorRuns.data(), colorRuns.size() });
     }
 
     return it;
@@ -727,6 +879,46 @@ catch (...)
 
         do
         {
+            // Text is often mostly ASCII with only the occasional non-ASCII character sprinkled in.
+            // Just like in ReplaceText(), any ASCII character that isn't followed by a non-ASCII one
+            // (for instance a combining mark) is a cluster of width 1 and doesn't need GraphemeNext().
+            // The same applies to CJK text, where most characters are wide clusters of their own.
+            if (const auto runBeg = it; standaloneCharWidth(*it))
+            {
+                while (it != end)
+                {
+                    const auto width = standaloneCharWidth(*it);
+                    if (!width || (it + 1 != end && !standaloneCharWidth(it[1])))
+                    {
+                        break;
+                    }
+
+                    if (colEnd + width > colLimit)
+                    {
+                        colEndDirty = colLimit;
+                        charsConsumed = ch - chBeg;
+                        return;
+                    }
+
+                    til::at(row._charOffsets, colEnd++) = gsl::narrow_cast<uint16_t>(ch);
+                    if (width == 2)
+                    {
+                        til::at(row._charOffsets, colEnd++) = gsl::narrow_cast<uint16_t>(ch | CharOffsetsTrailer);
+                    }
+                    ++ch;
+                    ++it;
+                }
+
+                if (it == end)
+                {
+                    break;
+                }
+                if (it != runBeg)
+                {
+                    state = GraphemeState{ .beg = &*it };
+                }
+            }
+
             cwd.GraphemeNext(state, chars);
 
             const auto width = std::max(1, state.width);
@@ -750,6 +942,44 @@ catch (...)
 
             ch += state.len;
             it += state.len;
+
+            // Runs of the same character are common as well: Box-drawing separators, progress bars, REP sequences.
+            // If a cluster consists of a single code unit and GraphemeNext() broke right before the next repetition
+            // of it, then each further repetition that is followed by yet another one is a cluster of the same width.
+            // The last repetition goes through GraphemeNext() again, as it may join with whatever comes after it.
+            if (state.len == 1 && it != end && *it == it[-1])
+            {
+                const auto repeated = *it;
+                const auto runBeg = it;
+
+                while (it != end && *it == repeated && (it + 1 == end || it[1] == repeated))
+                {
+                    const auto colEndRun = gsl::narrow_cast<uint16_t>(colEnd + width);
+                    if (colEndRun > colLimit)
+                    {
+                        colEndDirty = colLimit;
+                        charsConsumed = ch - chBeg;
+                        return;
+                    }
+
+                    til::at(row._charOffsets, colEnd++) = gsl::narrow_cast<uint16_t>(ch);
+                    while (colEnd < colEndRun)
+                    {
+                        til::at(row._charOffsets, colEnd++) = gsl::narrow_cast<uint16_t>(ch | CharOffsetsTrailer);
+                    }
+                    ++ch;
+                    ++it;
+                }
+
+                if (it == end)
+                {
+                    break;
+                }
+                if (it != runBeg)
+                {
+                    state = GraphemeState{ .beg = &*it };
+                }
+            }
         } while (it != end);
     }
 
@@ -914,6 +1144,16 @@ void ROW::_resizeChars(uint16_t colEndDirty, uint16_t chBegDirty, size_t chEndDi
     {
         std::copy_n(_chars.begin() + chEndDirtyOld, currentLength - chEndDirtyOld, _chars.begin() + chEndDirty);
     }
+    else if (_charsHeap && _chars.data() != _charsHeap.get() && newLength <= _charsHeapCapacity)
+    {
+        // Reuse the heap buffer that Reset() retained.
+        const std::span chars{ _charsHeap.get(), _charsHeapCapacity };
+
+        std::copy_n(_chars.begin(), chBegDirty, chars.begin());
+        std::copy_n(_chars.begin() + chEndDirtyOld, currentLength - chEndDirtyOld, chars.begin() + chEndDirty);
+
+        _chars = chars;
+    }
     else
     {
         const auto minCapacity = std::min<size_t>(UINT16_MAX, _chars.size() + (_chars.size() >> 1));
@@ -926,6 +1166,7 @@ void ROW::_resizeChars(uint16_t colEndDirty, uint16_t chBegDirty, size_t chEndDi
         std::copy_n(_chars.begin() + chEndDirtyOld, currentLength - chEndDirtyOld, chars.begin() + chEndDirty);
 
         _charsHeap = std::move(charsHeap);
+        _charsHeapCapacity = newCapacity;
         _chars = chars;
     }
 
@@ -999,17 +1240,7 @@ til::CoordType ROW::GetLastNonSpaceColumn() const noexcept
     const auto text = GetText();
     const auto beg = text.data();
     const auto end = beg + text.size();
-#pragma warning(suppress : 26429) // Symbol 'it' is never tested for nullness, it can be marked as not_null (f.23).
-    auto it = end;
-
-    for (; it != beg; --it)
-    {
-        // it[-1] is safe as `it` is always greater than `beg` (loop invariant).
-        if (it[-1] != L' ')
-        {
-            break;
-        }
-    }
+    const auto it = find_last_non_space(beg, end);
 
     // We're supposed to return the measurement in cells and not characters
     // and therefore simply calculating `it - beg` would be wrong.
@@ -1022,18 +1253,9 @@ til::CoordType ROW::GetLastNonSpaceColumn() const noexcept
 til::CoordType ROW::MeasureLeft() const noexcept
 {
     const auto text = GetText();
-    const auto beg = text.begin();
-    const auto end = text.end();
-    auto it = beg;
-
-    for (; it != end; ++it)
-    {
-        if (*it != L' ')
-        {
-            break;
-        }
-    }
-
+    const auto beg = text.data();
+    const auto end = beg + text.size();
+    const auto it = find_first_non_space(beg, end);
     return gsl::narrow_cast<til::CoordType>(it - beg);
 }
 
@@ -1057,19 +1279,9 @@ til::CoordType ROW::MeasureRight() const noexcept
 bool ROW::ContainsText() const noexcept
 {
     const auto text = GetText();
-    const auto beg = text.begin();
-    const auto end = text.end();
-    auto it = beg;
-
-    for (; it != end; ++it)
-    {
-        if (*it != L' ')
-        {
-            return true;
-        }
-    }
-
-    return false;
+    const auto beg = text.data();
+    const auto end = beg + text.size();
+    return find_first_non_space(beg, end) != end;
 }
 
 std::wstring_view ROW::GlyphAt(til::CoordType column) const noexcept
@@ -1239,6 +1451,16 @@ void ROW::SetScrollbarData(std::optional<ScrollbarData> data) noexcept
     _promptData = data;
 }
 
+uint64_t ROW::GetRevision() const noexcept
+{
+    return _revision;
+}
+
+void ROW::SetRevision(const uint64_t revision) noexcept
+{
+    _revision = revision;
+}
+
 void ROW::StartPrompt() noexcept
 {
     if (!_promptData.has_value())
@@ -134,6 +134,7 @@ public:
 
     void Reset(const TextAttribute& attr) noexcept;
     void CopyFrom(const ROW& source);
+    void Compact() noexcept;
 
     til::CoordType NavigateToPrevious(til::CoordType column) const noexcept;
     til::CoordType NavigateToNext(til::CoordType column) const noexcept;
@@ -173,6 +174,8 @@ public:
 
     const std::optional<ScrollbarData>& GetScrollbarData() const noexcept;
     void SetScrollbarData(std::optional<ScrollbarData> data) noexcept;
+    uint64_t GetRevision() const noexcept;
+    void SetRevision(uint64_t revision) noexcept;
     void StartPrompt() noexcept;
     void EndOutput(std::optional<unsigned int> error) noexcept;
 
@@ -257,9 +260,6 @@ private:
 
     // These fields are a bit "wasteful", but it makes all this a bit more robust against
     // programming errors during initial development (which is when this comment was written).
-    // * _chars and _charsHeap are redundant
-    //   If _charsHeap is stored in _chars, we can still infer that
-    //   _chars was allocated on the heap if _chars != _charsBuffer.
     // * _chars doesn't need a size_t size()
     //   The size may never exceed an uint16_t anyways.
     // * _charOffsets doesn't need a size() at all
@@ -272,8 +272,9 @@ private:
     wchar_t* _charsBuffer = nullptr;
     // ...but if this ROW needs to store more than _columnCount characters
     // then it will allocate a larger string on the heap and store it here.
-    // The capacity of this string on the heap is stored in _chars.size().
+    // Reset() keeps it around for reuse, so it may be allocated while _chars refers to _charsBuffer.
     std::unique_ptr<wchar_t[]> _charsHeap;
+    uint16_t _charsHeapCapacity = 0;
     // _chars either refers to our _charsBuffer or _charsHeap, defaulting to the former.
     // _chars.size() is NOT the length of the string, but rather its capacity.
     // _charOffsets[_columnCount] stores the length.
@@ -311,6 +312,10 @@ private:
 
     // Stores any image content covering the row.
     ImageSlice::Pointer _imageSlice;
+
+    // The TextBuffer mutation id at which this row was last handed out for modification.
+    // See TextBuffer::GetDirtyRows().
+    uint64_t _revision = 0;
 };
 
 #ifdef UNIT_TESTING
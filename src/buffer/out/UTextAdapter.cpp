@@ -6,6 +6,8 @@
 
 #include "textBuffer.hpp"
 
+#include <til/hash.h>
+
 // All of these are somewhat annoying when trying to implement RefcountBuffer.
 // You can't stuff a unique_ptr into ut->q (= void*) after all.
 #pragma warning(disable : 26402) // Return a scoped object instead of a heap-allocated if it has a move constructor (r.3).
@@ -411,6 +413,84 @@ Microsoft::Console::ICU::unique_uregex Microsoft::Console::ICU::CreateRegex(cons
     return unique_uregex{ re };
 }
 
+struct URegularExpressionInterner
+{
+    // Interns (caches) URegularExpression instances so that they can be reused. This method is thread-safe.
+    // uregex_open is not terribly expensive at ~10us/op, but it's also much more expensive than uregex_clone
+    // at ~400ns/op and would effectively double the time it takes to scan the viewport for patterns.
+    // The same applies to incremental searches, which only search through the few rows that changed.
+    //
+    // An alternative approach would be to not make this method thread-safe and give each
+    // Terminal instance its own cache. I'm not sure which approach would have been better.
+    Microsoft::Console::ICU::unique_uregex Intern(const std::wstring_view& pattern, uint32_t flags, UErrorCode* status)
+    {
+        {
+            const auto guard = _lock.lock_shared();
+            if (const auto it = _cache.find(pattern); it != _cache.end() && it->second.flags == flags)
+            {
+                return Microsoft::Console::ICU::unique_uregex{ uregex_clone(it->second.re.get(), status) };
+            }
+        }
+
+        // Patterns that failed to compile aren't cached, so that callers get the error reported every time.
+        // The same pattern with different flags replaces the previous entry, since it's unlikely to be used again.
+        auto re = Microsoft::Console::ICU::CreateRegex(pattern, flags, status);
+        if (U_FAILURE(*status))
+        {
+            return re;
+        }
+
+        Microsoft::Console::ICU::unique_uregex clone{ uregex_clone(re.get(), status) };
+        std::wstring key{ pattern };
+
+        const auto guard = _lock.lock_exclusive();
+
+        _cache.insert_or_assign(std::move(key), CacheValue{ std::move(re), flags, _totalInsertions });
+        _totalInsertions++;
+
+        // If the cache is full remove the oldest element (oldest = lowest generation, just like with humans).
+        if (_cache.size() > cacheSizeLimit)
+        {
+            _cache.erase(std::min_element(_cache.begin(), _cache.end(), [](const auto& it, const auto& smallest) {
+                return it.second.generation < smallest.second.generation;
+            }));
+        }
+
+        return clone;
+    }
+
+private:
+    struct CacheValue
+    {
+        Microsoft::Console::ICU::unique_uregex re;
+        uint32_t flags = 0;
+        size_t generation = 0;
+    };
+
+    struct CacheKeyHasher
+    {
+        using is_transparent = void;
+
+        std::size_t operator()(const std::wstring_view& str) const noexcept
+        {
+            return til::hash(str);
+        }
+    };
+
+    static constexpr size_t cacheSizeLimit = 128;
+    wil::srwlock _lock;
+    std::unordered_map<std::wstring, CacheValue, CacheKeyHasher, std::equal_to<>> _cache;
+    size_t _totalInsertions = 0;
+};
+
+static URegularExpressionInterner uregexInterner;
+
+// Same as CreateRegex(), but returns a clone of a process-wide cached instance if one exists.
+Microsoft::Console::ICU::unique_uregex Microsoft::Console::ICU::InternRegex(const std::wstring_view& pattern, uint32_t flags, UErrorCode* status)
+{
+    return uregexInterner.Intern(pattern, flags, status);
+}
+
 // Returns an inclusive point range given a text start and end position.
 // This function is designed to be used with uregex_start64/uregex_end64.
 til::point_span Microsoft::Console::ICU::BufferRangeFromMatch(UText* ut, URegularExpression* re)
@@ -13,21 +13,42 @@ bool Search::IsStale(const Microsoft::Console::Render::IRenderData& renderData,
     return _renderData != &renderData ||
            _needle != needle ||
            _flags != flags ||
-           _lastMutationId != renderData.GetTextBuffer().GetLastMutationId();
+           _revision.mutationId != renderData.GetTextBuffer().GetLastMutationId();
 }
 
 void Search::Reset(Microsoft::Console::Render::IRenderData& renderData, const std::wstring_view& needle, SearchFlag flags, bool reverse)
 {
     const auto& textBuffer = renderData.GetTextBuffer();
+    const auto dirty = textBuffer.GetDirtyRows(_revision);
+    const auto literal = WI_IsFlagClear(flags, SearchFlag::RegularExpression) && needle.find_first_of(L"\r\n") == std::wstring_view::npos;
+    const auto incremental = dirty && _ok && _renderData == &renderData && _needle == needle && _flags == flags && literal;
+    // Case-insensitive matching uses full case folding (e.g. "ss" matches "ß"), where a match
+    // for the longer needle doesn't necessarily start with a match for the shorter one.
+    const auto refinement = _ok && _renderData == &renderData && _flags == flags && literal &&
+                            WI_IsFlagClear(flags, SearchFlag::CaseInsensitive) &&
+                            _revision.mutationId == textBuffer.GetLastMutationId() &&
+                            !_needle.empty() && needle.size() > _needle.size() && needle.starts_with(_needle);
 
     _renderData = &renderData;
     _needle = needle;
     _flags = flags;
-    _lastMutationId = textBuffer.GetLastMutationId();
+    _revision = textBuffer.GetRevisionCursor();
+
+    if (refinement)
+    {
+        _refineResults(textBuffer);
+    }
+    else if (incremental)
+    {
+        _updateResults(textBuffer, *dirty);
+    }
+    else
+    {
+        auto result = textBuffer.SearchText(needle, _flags);
+        _ok = result.has_value();
+        _results = std::move(result).value_or(std::vector<til::point_span>{});
+    }
 
-    auto result = textBuffer.SearchText(needle, _flags);
-    _ok = result.has_value();
-    _results = std::move(result).value_or(std::vector<til::point_span>{});
     _index = reverse ? gsl::narrow_cast<ptrdiff_t>(_results.size()) - 1 : 0;
     _step = reverse ? -1 : 1;
 
@@ -41,6 +62,77 @@ void Search::Reset(Microsoft::Console::Render::IRenderData& renderData, const st
     }
 }
 
+// When new output arrives while a search is active (for instance a build log with search highlighting),
+// we only need to search through the rows that changed. The remaining results only need their
+// coordinates adjusted for how far the buffer scrolled. Only valid for literal needles without
+// line breaks, because those can't match across the logical lines (= rows joined by WasWrapForced()).
+void Search::_updateResults(const TextBuffer& textBuffer, const TextBuffer::DirtyRows& dirty)
+{
+    // Rescanning must start at the beginning of the logical line that contains the first dirty row.
+    auto rowBeg = dirty.begin;
+    while (rowBeg > 0 && textBuffer.GetRowByOffset(rowBeg - 1).WasWrapForced())
+    {
+        --rowBeg;
+    }
+
+    // Results are sorted. Drop those that scrolled out of the buffer or that are in rows we're about to rescan.
+    // The latter may compare unequal to what we would've otherwise searched in that row (e.g. a match near
+    // the end of a row in a logical line that got partially scrolled out), but that's inconsequential.
+    const auto first = std::find_if(_results.begin(), _results.end(), [&](const auto& r) { return r.start.y >= dirty.scrolled; });
+    const auto last = std::find_if(first, _results.end(), [&](const auto& r) { return r.start.y - dirty.scrolled >= rowBeg; });
+    _results.erase(last, _results.end());
+    _results.erase(_results.begin(), first);
+
+    for (auto& r : _results)
+    {
+        r.start.y -= dirty.scrolled;
+        r.end.y -= dirty.scrolled;
+    }
+
+    if (auto result = textBuffer.SearchText(_needle, _flags, rowBeg, til::CoordTypeMax))
+    {
+        _results.insert(_results.end(), result->begin(), result->end());
+    }
+}
+
+// While the user is typing into the search box, each keystroke usually appends to the needle.
+// Every match of the new, longer needle then starts where a match of the old one did, so only
+// the logical lines that contain an existing result need to be searched again.
+void Search::_refineResults(const TextBuffer& textBuffer)
+{
+    std::vector<til::point_span> results;
+    til::CoordType searchedEnd = 0;
+
+    for (const auto& r : _results)
+    {
+        if (r.start.y < searchedEnd)
+        {
+            continue;
+        }
+
+        auto rowBeg = r.start.y;
+        while (rowBeg > searchedEnd && textBuffer.GetRowByOffset(rowBeg - 1).WasWrapForced())
+        {
+            --rowBeg;
+        }
+
+        auto rowEnd = r.start.y + 1;
+        while (textBuffer.GetRowByOffset(rowEnd - 1).WasWrapForced() && rowEnd < textBuffer.GetSize().Height())
+        {
+            ++rowEnd;
+        }
+
+        if (auto result = textBuffer.SearchText(_needle, _flags, rowBeg, rowEnd))
+        {
+            results.insert(results.end(), result->begin(), result->end());
+        }
+
+        searchedEnd = rowEnd;
+    }
+
+    _results = std::move(results);
+}
+
 void Search::MoveToPoint(const til::point anchor) noexcept
 {
     if (_results.empty())
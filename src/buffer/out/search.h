@@ -51,11 +51,14 @@ public:
     bool IsOk() const noexcept;
 
 private:
+    void _updateResults(const TextBuffer& textBuffer, const TextBuffer::DirtyRows& dirty);
+    void _refineResults(const TextBuffer& textBuffer);
+
     // _renderData is a pointer so that Search() is constexpr default constructable.
     Microsoft::Console::Render::IRenderData* _renderData = nullptr;
     std::wstring _needle;
     SearchFlag _flags{};
-    uint64_t _lastMutationId = 0;
+    TextBuffer::RevisionCursor _revision;
 
     bool _ok{ false };
     std::vector<til::point_span> _results;
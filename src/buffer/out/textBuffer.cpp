@@ -5,6 +5,7 @@
 #include "textBuffer.hpp"
 
 #include <til/hash.h>
+#include <til/latch.h>
 
 #include "UTextAdapter.h"
 #include "../../types/inc/CodepointWidthDetector.hpp"
@@ -56,6 +57,7 @@ TextBuffer::TextBuffer(til::size screenBufferSize,
     // This way every TextBuffer will start with a ""unique"" _lastMutationId
     // and so it'll compare unequal with the counter of other TextBuffers.
     _lastMutationId{ s_lastMutationIdInitialValue.fetch_add(0x100000000) },
+    _rowsMovedMutationId{ _lastMutationId },
     _cursor{ cursorSize, *this },
     _isActiveBuffer{ isActiveBuffer }
 {
@@ -148,6 +150,34 @@ void TextBuffer::_decommit() noexcept
     _destroy();
     VirtualFree(_buffer.get(), 0, MEM_DECOMMIT);
     _commitWatermark = _buffer.get();
+    _invalidateDirtyRows();
+}
+
+// Destructs all ROWs starting at the given row pointer and MEM_DECOMMITs the whole pages past it.
+// Unlike _decommit() this keeps the rows in front of it intact. The page that the given row
+// starts in may still be shared with the preceding (kept) rows, which is why it stays committed.
+void TextBuffer::_decommitFrom(std::byte* row) noexcept
+{
+    if (row >= _commitWatermark)
+    {
+        return;
+    }
+
+    for (auto it = row; it < _commitWatermark; it += _bufferRowStride)
+    {
+        std::destroy_at(reinterpret_cast<ROW*>(it));
+    }
+
+    // The page size is 4KiB on all architectures we support. VirtualFree() will decommit
+    // all pages that overlap with [pagesBeg,_commitWatermark), so pagesBeg must be aligned.
+    constexpr uintptr_t pageSize = 4096;
+    const auto pagesBeg = reinterpret_cast<std::byte*>((reinterpret_cast<uintptr_t>(row) + pageSize - 1) & ~(pageSize - 1));
+    if (pagesBeg < _commitWatermark)
+    {
+        VirtualFree(pagesBeg, gsl::narrow_cast<size_t>(_commitWatermark - pagesBeg), MEM_DECOMMIT);
+    }
+
+    _commitWatermark = row;
 }
 
 // Constructs ROWs between [_commitWatermark,until).
@@ -230,7 +260,11 @@ const ROW& TextBuffer::GetRowByOffset(const til::CoordType index) const
 ROW& TextBuffer::GetMutableRowByOffset(const til::CoordType index)
 {
     _lastMutationId++;
-    return _getRow(index);
+    auto& watermark = _dirtyWatermarks[_dirtyWatermarkHead].row;
+    watermark = std::min(watermark, index);
+    auto& row = _getRow(index);
+    row.SetRevision(_lastMutationId);
+    return row;
 }
 
 // Returns a row filled with whitespace and the current attributes, for you to freely use.
@@ -719,7 +753,26 @@ void TextBuffer::IncrementCircularBuffer(const TextAttribute& fillAttributes)
     _PruneHyperlinks();
 
     // Second, clean out the old "first row" as it will become the "last row" of the buffer after the circle is performed.
-    GetMutableRowByOffset(0).Reset(fillAttributes);
+    // This doesn't use GetMutableRowByOffset(), because we don't want row 0 to be marked as dirty, but rather the
+    // new last row. The existing dirty watermarks move up by one, just like everything else. See GetDirtyRows().
+    _lastMutationId++;
+    {
+        auto& row = _getRow(0);
+        row.SetRevision(_lastMutationId);
+        row.Reset(fillAttributes);
+    }
+    for (auto& watermark : _dirtyWatermarks)
+    {
+        if (watermark.row != til::CoordTypeMax)
+        {
+            watermark.row = std::max(0, watermark.row - 1);
+        }
+    }
+    {
+        auto& watermark = _dirtyWatermarks[_dirtyWatermarkHead].row;
+        watermark = std::min<til::CoordType>(watermark, _height - 1);
+    }
+    _scrollCount++;
     {
         // Now proceed to increment.
         // Incrementing it will cause the next line down to become the new "top" of the window (the new "0" in logical coordinates)
@@ -731,6 +784,13 @@ void TextBuffer::IncrementCircularBuffer(const TextAttribute& fillAttributes)
             _firstRow = 0;
         }
     }
+
+    // Every row passes this distance exactly once per cycle through the circular buffer,
+    // which makes it an inexpensive spot to drop the growth slack of rows that went cold.
+    if (_height > _compactRowDistance)
+    {
+        _getRow(_height - _compactRowDistance).Compact();
+    }
 }
 
 //Routine Description:
@@ -789,6 +849,7 @@ const Viewport TextBuffer::GetSize() const noexcept
 void TextBuffer::_SetFirstRowIndex(const til::CoordType FirstRowIndex) noexcept
 {
     _firstRow = FirstRowIndex;
+    _invalidateDirtyRows();
 }
 
 void TextBuffer::ScrollRows(const til::CoordType firstRow, til::CoordType size, const til::CoordType delta)
@@ -869,6 +930,56 @@ void TextBuffer::CopyRow(const til::CoordType srcRowIndex, const til::CoordType
     ImageSlice::CopyRow(srcRow, dstRow);
 }
 
+// Copies the text and attributes of `width` columns from one row to another, which may be the same row.
+// Wide glyphs that get cut in half at either end of the segment are replaced with whitespace.
+// Image content isn't copied, since callers usually want to use ImageSlice::CopyBlock() for the whole area.
+void TextBuffer::CopyRowSegment(const til::CoordType srcRowIndex, const til::CoordType srcColumn, const til::CoordType dstRowIndex, const til::CoordType dstColumn, const til::CoordType width)
+{
+    if (width <= 0)
+    {
+        return;
+    }
+
+    auto& dstRow = GetMutableRowByOffset(dstRowIndex);
+    auto srcRow = &GetRowByOffset(srcRowIndex);
+
+    // ROW::CopyTextFrom() can't copy a row onto itself, so we make a backup of it first.
+    if (srcRow == &dstRow)
+    {
+        auto& scratch = GetScratchpadRow();
+        scratch.CopyFrom(dstRow);
+        srcRow = &scratch;
+    }
+
+    const auto dstLimit = dstColumn + width;
+    auto srcBeg = srcColumn;
+    auto dstBeg = dstColumn;
+
+    // ROW::CopyTextFrom() doesn't copy anything if the source starts with the trailing half of a wide glyph.
+    if (srcRow->DbcsAttrAt(srcBeg) == DbcsAttribute::Trailing)
+    {
+        dstRow.ReplaceCharacters(dstBeg, 1, L" ");
+        ++srcBeg;
+        ++dstBeg;
+    }
+
+    RowCopyTextFromState state{
+        .source = *srcRow,
+        .columnBegin = dstBeg,
+        .columnLimit = dstLimit,
+        .sourceColumnBegin = srcBeg,
+        .sourceColumnLimit = srcColumn + width,
+    };
+    dstRow.CopyTextFrom(state);
+
+    const auto copyAttr = srcRow->Attributes().slice(gsl::narrow<uint16_t>(srcColumn), gsl::narrow<uint16_t>(srcColumn + width));
+    dstRow.Attributes().replace(gsl::narrow<uint16_t>(dstColumn), gsl::narrow<uint16_t>(dstLimit), copyAttr);
+
+    const auto dirtyBeg = std::min(dstColumn, state.columnBeginDirty);
+    const auto dirtyEnd = std::max(dstLimit, state.columnEndDirty);
+    TriggerRedraw(Viewport::FromExclusive({ dirtyBeg, dstRowIndex, dirtyEnd, dstRowIndex + 1 }));
+}
+
 Cursor& TextBuffer::GetCursor() noexcept
 {
     return _cursor;
@@ -884,6 +995,75 @@ uint64_t TextBuffer::GetLastMutationId() const noexcept
     return _lastMutationId;
 }
 
+// Returns a snapshot of the current revision of the buffer contents.
+// Pass it to GetDirtyRows() later to find out what changed since.
+TextBuffer::RevisionCursor TextBuffer::GetRevisionCursor() const noexcept
+{
+    // Start a new watermark generation, unless nothing changed since the current one started.
+    if (_dirtyWatermarks[_dirtyWatermarkHead].mutationId != _lastMutationId)
+    {
+        _dirtyWatermarkHead = (_dirtyWatermarkHead + 1) % _dirtyWatermarks.size();
+        _dirtyWatermarks[_dirtyWatermarkHead] = { _lastMutationId, til::CoordTypeMax };
+    }
+    return { _lastMutationId, _scrollCount };
+}
+
+// Returns which rows may have been modified since the given cursor was retrieved,
+// allowing callers like Search to only update the parts they've cached that have changed.
+// Every ROW stores the mutation id at which it was last modified (ROW::GetRevision()),
+// so callers that need more detail than `begin` can compare them against `cursor.mutationId`.
+// Returns nullopt if that information isn't available anymore, in which case the caller must assume that
+// everything changed. This happens for instance if the buffer was cleared or if the `cursor` is from
+// another TextBuffer. The cursor isn't consumed, so any number of callers can track the buffer this way.
+std::optional<TextBuffer::DirtyRows> TextBuffer::GetDirtyRows(const RevisionCursor& cursor) const
+{
+    if (cursor.mutationId < _rowsMovedMutationId || cursor.mutationId > _lastMutationId || cursor.scrollCount > _scrollCount)
+    {
+        return std::nullopt;
+    }
+
+    // All rows modified since the cursor was retrieved are at or below the watermarks of the generations
+    // from the cursor's one onwards. If the cursor is older than the oldest generation, we start at row 0.
+    til::CoordType begin = 0;
+    auto lowest = til::CoordTypeMax;
+    for (size_t i = 0; i < _dirtyWatermarks.size(); ++i)
+    {
+        const auto& watermark = _dirtyWatermarks[(_dirtyWatermarkHead + _dirtyWatermarks.size() - i) % _dirtyWatermarks.size()];
+        if (watermark.mutationId == UINT64_MAX)
+        {
+            break;
+        }
+        lowest = std::min(lowest, watermark.row);
+        if (watermark.mutationId <= cursor.mutationId)
+        {
+            begin = lowest;
+            break;
+        }
+    }
+
+    // Rows past the last committed one have never been written to.
+    // A generation may have started before the cursor, so there may still be a few clean rows to skip.
+    const auto end = _estimateOffsetOfLastCommittedRow() + 1;
+    begin = std::clamp(begin, 0, end);
+    for (; begin < end && GetRowByOffset(begin).GetRevision() <= cursor.mutationId; ++begin)
+    {
+    }
+
+    return DirtyRows{
+        .scrolled = gsl::narrow_cast<til::CoordType>(std::min<uint64_t>(_scrollCount - cursor.scrollCount, til::CoordTypeMax)),
+        .begin = begin,
+    };
+}
+
+// Call this whenever rows change their position other than through IncrementCircularBuffer().
+void TextBuffer::_invalidateDirtyRows() noexcept
+{
+    _lastMutationId++;
+    _rowsMovedMutationId = _lastMutationId;
+    _dirtyWatermarks.fill({});
+    _dirtyWatermarks[_dirtyWatermarkHead] = { _lastMutationId, til::CoordTypeMax };
+}
+
 const TextAttribute& TextBuffer::GetCurrentAttributes() const noexcept
 {
     return _currentAttributes;
@@ -1004,13 +1184,14 @@ void TextBuffer::ClearScrollback(const til::CoordType newFirstRow, const til::Co
     // operates modulo the buffer height and so the possibly-too-large startAbsolute won't be an issue.
     const auto startAbsolute = _firstRow + newFirstRow;
     _firstRow = 0;
+    _invalidateDirtyRows();
     ScrollRows(startAbsolute, rowsToKeep, -startAbsolute);
 
-    const auto end = _estimateOffsetOfLastCommittedRow();
-    for (auto y = rowsToKeep; y <= end; ++y)
-    {
-        GetMutableRowByOffset(y).Reset(_initialAttributes);
-    }
+    // Everything past the kept rows is unused now. Instead of resetting those rows (which kept a buffer that
+    // once scrolled deep fully committed), we destroy and decommit them. _getRowByOffsetDirect() will
+    // commit and construct them again on demand with _initialAttributes, which is equivalent to a Reset().
+    // The +1 accounts for the scratchpad row at offset 0.
+    _decommitFrom(_buffer.get() + _bufferRowStride * (gsl::narrow_cast<size_t>(std::min(rowsToKeep, _height)) + 1));
 }
 
 // Routine Description:
@@ -1132,6 +1313,18 @@ DelimiterClass TextBuffer::_GetDelimiterClassAt(const til::point pos, const std:
     return GetRowByOffset(realPos.y).DelimiterClassAt(realPos.x, wordDelimiters);
 }
 
+// Method Description:
+// - Returns the screen column one past the last non-whitespace character of the given row.
+// - All cells from there on are spaces (and thus DelimiterClass::ControlChar).
+// Arguments:
+// - y: the row under observation
+// Return Value:
+// - the screen column, accounting for double width lines
+til::CoordType TextBuffer::_GetScreenTextEnd(const til::CoordType y) const
+{
+    return BufferToScreenPosition({ GetRowByOffset(y).MeasureRight(), y }).x;
+}
+
 // Method Description:
 // - Get the til::point for the beginning of the word you are on
 // Arguments:
@@ -1197,10 +1390,23 @@ til::point TextBuffer::_GetWordStartForAccessibility(const til::point target, co
 {
     auto result = target;
     const auto bufferSize = GetSize();
+    til::CoordType textEndY = -1;
+    til::CoordType textEnd = 0;
 
     // ignore left boundary. Continue until readable text found
     while (_GetDelimiterClassAt(result, wordDelimiters) != DelimiterClass::RegularChar)
     {
+        // Everything past the last character of a row is whitespace. Skip it in one go.
+        if (result.y != textEndY)
+        {
+            textEndY = result.y;
+            textEnd = _GetScreenTextEnd(result.y);
+        }
+        if (result.x > textEnd)
+        {
+            result.x = textEnd;
+        }
+
         if (result == bufferSize.Origin())
         {
             //looped around and hit origin (no word between origin and target)
@@ -1346,8 +1552,25 @@ til::point TextBuffer::_GetWordEndForAccessibility(const til::point target, cons
             bufferSize.IncrementInBounds(result);
         }
 
+        til::CoordType textEndY = -1;
+        til::CoordType textEnd = 0;
         while (result != limit && result != bufferSize.BottomRightInclusive() && _GetDelimiterClassAt(result, wordDelimiters) != DelimiterClass::RegularChar)
         {
+            // Everything past the last character of a row is whitespace. Skip it in one go,
+            // unless the limit is on this row, as we must not step past it.
+            if (result.y != limit.y)
+            {
+                if (result.y != textEndY)
+                {
+                    textEndY = result.y;
+                    textEnd = _GetScreenTextEnd(result.y);
+                }
+                if (result.x >= textEnd)
+                {
+                    result.x = bufferSize.RightInclusive();
+                }
+            }
+
             // expand to the beginning of the NEXT word
             bufferSize.IncrementInBounds(result);
         }
@@ -1425,6 +1648,15 @@ void TextBuffer::_PruneHyperlinks()
         // doesn't when the set is empty (saving an allocation in the common case of no links.)
         std::unordered_set<uint16_t> firstRowRefs{ hyperlinks.cbegin(), hyperlinks.cend() };
 
+        // Rows that were last modified before any of these IDs were handed out can't contain them.
+        // Programs like `ls --hyperlink` print a new ID on every line, so this skips most of the buffer.
+        auto oldestRevision = std::numeric_limits<uint64_t>::max();
+        for (const auto id : firstRowRefs)
+        {
+            const auto it = _hyperlinkRevisions.find(id);
+            oldestRevision = std::min(oldestRevision, it != _hyperlinkRevisions.end() ? it->second : 0);
+        }
+
         const auto total = TotalRowCount();
         // Loop through all the rows in the buffer except the first row -
         // we have found all hyperlink references in the first row and put them in refs,
@@ -1432,12 +1664,17 @@ void TextBuffer::_PruneHyperlinks()
         // to see if those references are anywhere else
         for (til::CoordType i = 1; i < total; ++i)
         {
-            const auto nextRowRefs = GetRowByOffset(i).GetHyperlinks();
-            for (auto id : nextRowRefs)
+            const auto& row = GetRowByOffset(i);
+            if (row.GetRevision() <= oldestRevision)
+            {
+                continue;
+            }
+
+            for (const auto& run : row.Attributes().runs())
             {
-                if (firstRowRefs.find(id) != firstRowRefs.end())
+                if (run.value.IsHyperlink())
                 {
-                    firstRowRefs.erase(id);
+                    firstRowRefs.erase(run.value.GetHyperlinkId());
                 }
             }
             if (firstRowRefs.empty())
@@ -1898,7 +2135,20 @@ std::wstring TextBuffer::GetPlainText(const CopyRequest& req) const
         return {};
     }
 
+    // Large selections (say, an entire scrollback) would otherwise grow the string
+    // geometrically and copy megabytes of text over and over. Measuring the rows
+    // first is cheap, since ROW::GetText() only returns a view into the row.
+    size_t length = 0;
+    for (auto iRow = req.beg.y; iRow <= req.end.y; ++iRow)
+    {
+        const auto& row = GetRowByOffset(iRow);
+        const auto& [rowBeg, rowEnd, addLineBreak] = _RowCopyHelper(req, iRow, row);
+        length += row.GetText(rowBeg, rowEnd).size();
+        length += addLineBreak && iRow != req.end.y ? 2 : 0;
+    }
+
     std::wstring selectedText;
+    selectedText.reserve(length);
 
     for (auto iRow = req.beg.y; iRow <= req.end.y; ++iRow)
     {
@@ -1946,7 +2196,12 @@ std::string TextBuffer::GenHTML(const CopyRequest& req,
 
     try
     {
-        std::string htmlBuilder;
+        // once filled with values, there will be exactly 157 bytes in the clipboard header
+        constexpr size_t ClipboardHeaderSize = 157;
+
+        // The clipboard header is written into this space at the very end, once all offsets are known.
+        // This way we don't need to concatenate the header and the (potentially huge) HTML into a new string.
+        std::string htmlBuilder(ClipboardHeaderSize, '\0');
 
         // First we have to add some standard HTML boiler plate required for
         // CF_HTML as part of the HTML Clipboard format
@@ -1974,6 +2229,12 @@ std::string TextBuffer::GenHTML(const CopyRequest& req,
             htmlBuilder += "\">";
         }
 
+        // These are reused across runs to avoid reallocating them for each one.
+        std::string spanBuilder;
+        std::string openSpan;
+        std::string_view closeSpan;
+        std::string unescapedText;
+
         for (auto iRow = req.beg.y; iRow <= req.end.y; ++iRow)
         {
             const auto& row = GetRowByOffset(iRow);
@@ -1995,23 +2256,24 @@ std::string TextBuffer::GenHTML(const CopyRequest& req,
                 const auto isCrossedOut = attr.IsCrossedOut();
                 const auto isOverlined = attr.IsOverlined();
 
-                htmlBuilder += "<SPAN STYLE=\"";
-                fmt::format_to(std::back_inserter(htmlBuilder), FMT_COMPILE("color:{};"), fgHex);
-                fmt::format_to(std::back_inserter(htmlBuilder), FMT_COMPILE("background-color:{};"), bgHex);
+                spanBuilder.clear();
+                spanBuilder += "<SPAN STYLE=\"";
+                fmt::format_to(std::back_inserter(spanBuilder), FMT_COMPILE("color:{};"), fgHex);
+                fmt::format_to(std::back_inserter(spanBuilder), FMT_COMPILE("background-color:{};"), bgHex);
 
                 if (isIntenseBold && attr.IsIntense())
                 {
-                    htmlBuilder += "font-weight:bold;";
+                    spanBuilder += "font-weight:bold;";
                 }
 
                 if (attr.IsItalic())
                 {
-                    htmlBuilder += "font-style:italic;";
+                    spanBuilder += "font-style:italic;";
                 }
 
                 if (isCrossedOut || isOverlined)
                 {
-                    fmt::format_to(std::back_inserter(htmlBuilder),
+                    fmt::format_to(std::back_inserter(spanBuilder),
                                    FMT_COMPILE("text-decoration:{} {} {};"),
                                    isCrossedOut ? "line-through" : "",
                                    isOverlined ? "overline" : "",
@@ -2024,35 +2286,45 @@ std::string TextBuffer::GenHTML(const CopyRequest& req,
                     // we cannot apply different colors to them at the same time. However, we
                     // can achieve the desired result by creating a nested <span> and applying
                     // underline style and color to it.
-                    htmlBuilder += "\"><SPAN STYLE=\"";
+                    spanBuilder += "\"><SPAN STYLE=\"";
 
                     switch (ulStyle)
                     {
                     case UnderlineStyle::NoUnderline:
                         break;
                     case UnderlineStyle::DoublyUnderlined:
-                        fmt::format_to(std::back_inserter(htmlBuilder), FMT_COMPILE("text-decoration:underline double {};"), ulHex);
+                        fmt::format_to(std::back_inserter(spanBuilder), FMT_COMPILE("text-decoration:underline double {};"), ulHex);
                         break;
                     case UnderlineStyle::CurlyUnderlined:
-                        fmt::format_to(std::back_inserter(htmlBuilder), FMT_COMPILE("text-decoration:underline wavy {};"), ulHex);
+                        fmt::format_to(std::back_inserter(spanBuilder), FMT_COMPILE("text-decoration:underline wavy {};"), ulHex);
                         break;
                     case UnderlineStyle::DottedUnderlined:
-                        fmt::format_to(std::back_inserter(htmlBuilder), FMT_COMPILE("text-decoration:underline dotted {};"), ulHex);
+                        fmt::format_to(std::back_inserter(spanBuilder), FMT_COMPILE("text-decoration:underline dotted {};"), ulHex);
                         break;
                     case UnderlineStyle::DashedUnderlined:
-                        fmt::format_to(std::back_inserter(htmlBuilder), FMT_COMPILE("text-decoration:underline dashed {};"), ulHex);
+                        fmt::format_to(std::back_inserter(spanBuilder), FMT_COMPILE("text-decoration:underline dashed {};"), ulHex);
                         break;
                     case UnderlineStyle::SinglyUnderlined:
                     default:
-                        fmt::format_to(std::back_inserter(htmlBuilder), FMT_COMPILE("text-decoration:underline {};"), ulHex);
+                        fmt::format_to(std::back_inserter(spanBuilder), FMT_COMPILE("text-decoration:underline {};"), ulHex);
                         break;
                     }
                 }
 
-                htmlBuilder += "\">";
+                spanBuilder += "\">";
+
+                // Attributes that differ in ways that aren't visible in HTML (e.g. hyperlink IDs or
+                // palette indices that map to the same color) produce identical spans. We coalesce those.
+                if (spanBuilder != openSpan)
+                {
+                    htmlBuilder += closeSpan;
+                    htmlBuilder += spanBuilder;
+                    std::swap(openSpan, spanBuilder);
+                    // close the nested span we created for underline
+                    closeSpan = isUnderlined ? "</SPAN></SPAN>" : "</SPAN>";
+                }
 
                 // text
-                std::string unescapedText;
                 THROW_IF_FAILED(til::u16u8(row.GetText(x, nextX), unescapedText));
                 for (const auto c : unescapedText)
                 {
@@ -2072,18 +2344,14 @@ std::string TextBuffer::GenHTML(const CopyRequest& req,
                     }
                 }
 
-                if (isUnderlined)
-                {
-                    // close the nested span we created for underline
-                    htmlBuilder += "</SPAN>";
-                }
-
-                htmlBuilder += "</SPAN>";
-
                 // advance to next run of text
                 x = nextX;
             }
 
+            htmlBuilder += closeSpan;
+            openSpan.clear();
+            closeSpan = {};
+
             // never add line break to the last row.
             if (addLineBreak && iRow < req.end.y)
             {
@@ -2098,26 +2366,24 @@ std::string TextBuffer::GenHTML(const CopyRequest& req,
         constexpr std::string_view HtmlFooter = "</BODY></HTML>";
         htmlBuilder += HtmlFooter;
 
-        // once filled with values, there will be exactly 157 bytes in the clipboard header
-        constexpr size_t ClipboardHeaderSize = 157;
-
         // these values are byte offsets from start of clipboard
         const auto htmlStartPos = ClipboardHeaderSize;
-        const auto htmlEndPos = ClipboardHeaderSize + gsl::narrow<size_t>(htmlBuilder.length());
+        const auto htmlEndPos = gsl::narrow<size_t>(htmlBuilder.length());
         const auto fragStartPos = ClipboardHeaderSize + gsl::narrow<size_t>(htmlHeader.length());
         const auto fragEndPos = htmlEndPos - HtmlFooter.length();
 
         // header required by HTML 0.9 format
-        std::string clipHeaderBuilder;
-        clipHeaderBuilder += "Version:0.9\r\n";
-        fmt::format_to(std::back_inserter(clipHeaderBuilder), FMT_COMPILE("StartHTML:{:0>10}\r\n"), htmlStartPos);
-        fmt::format_to(std::back_inserter(clipHeaderBuilder), FMT_COMPILE("EndHTML:{:0>10}\r\n"), htmlEndPos);
-        fmt::format_to(std::back_inserter(clipHeaderBuilder), FMT_COMPILE("StartFragment:{:0>10}\r\n"), fragStartPos);
-        fmt::format_to(std::back_inserter(clipHeaderBuilder), FMT_COMPILE("EndFragment:{:0>10}\r\n"), fragEndPos);
-        fmt::format_to(std::back_inserter(clipHeaderBuilder), FMT_COMPILE("StartSelection:{:0>10}\r\n"), fragStartPos);
-        fmt::format_to(std::back_inserter(clipHeaderBuilder), FMT_COMPILE("EndSelection:{:0>10}\r\n"), fragEndPos);
-
-        return clipHeaderBuilder + htmlBuilder;
+        auto clipHeader = htmlBuilder.begin();
+        clipHeader = fmt::format_to(clipHeader, FMT_COMPILE("Version:0.9\r\n"));
+        clipHeader = fmt::format_to(clipHeader, FMT_COMPILE("StartHTML:{:0>10}\r\n"), htmlStartPos);
+        clipHeader = fmt::format_to(clipHeader, FMT_COMPILE("EndHTML:{:0>10}\r\n"), htmlEndPos);
+        clipHeader = fmt::format_to(clipHeader, FMT_COMPILE("StartFragment:{:0>10}\r\n"), fragStartPos);
+        clipHeader = fmt::format_to(clipHeader, FMT_COMPILE("EndFragment:{:0>10}\r\n"), fragEndPos);
+        clipHeader = fmt::format_to(clipHeader, FMT_COMPILE("StartSelection:{:0>10}\r\n"), fragStartPos);
+        clipHeader = fmt::format_to(clipHeader, FMT_COMPILE("EndSelection:{:0>10}\r\n"), fragEndPos);
+        assert(clipHeader == htmlBuilder.begin() + ClipboardHeaderSize);
+
+        return htmlBuilder;
     }
     catch (...)
     {
@@ -2224,6 +2490,10 @@ std::string TextBuffer::GenRTF(const CopyRequest& req,
         // color. See: Spec 1.9.1, Pg. 23.
         fmt::format_to(std::back_inserter(contentBuilder), FMT_COMPILE("\\chshdng0\\chcbpat{}"), getColorTableIndex(backgroundColor));
 
+        // These are reused across runs to avoid reallocating them for each one.
+        std::string groupBuilder;
+        std::string openGroup;
+
         for (auto iRow = req.beg.y; iRow <= req.end.y; ++iRow)
         {
             const auto& row = GetRowByOffset(iRow);
@@ -2244,24 +2514,25 @@ std::string TextBuffer::GenRTF(const CopyRequest& req,
 
                 // start an RTF group that can be closed later to restore the
                 // default attribute.
-                contentBuilder += "{";
+                groupBuilder.clear();
+                groupBuilder += "{";
 
-                fmt::format_to(std::back_inserter(contentBuilder), FMT_COMPILE("\\cf{}"), fgIdx);
-                fmt::format_to(std::back_inserter(contentBuilder), FMT_COMPILE("\\chshdng0\\chcbpat{}"), bgIdx);
+                fmt::format_to(std::back_inserter(groupBuilder), FMT_COMPILE("\\cf{}"), fgIdx);
+                fmt::format_to(std::back_inserter(groupBuilder), FMT_COMPILE("\\chshdng0\\chcbpat{}"), bgIdx);
 
                 if (isIntenseBold && attr.IsIntense())
                 {
-                    contentBuilder += "\\b";
+                    groupBuilder += "\\b";
                 }
 
                 if (attr.IsItalic())
                 {
-                    contentBuilder += "\\i";
+                    groupBuilder += "\\i";
                 }
 
                 if (attr.IsCrossedOut())
                 {
-                    contentBuilder += "\\strike";
+                    groupBuilder += "\\strike";
                 }
 
                 switch (ulStyle)
@@ -2269,37 +2540,53 @@ std::string TextBuffer::GenRTF(const CopyRequest& req,
                 case UnderlineStyle::NoUnderline:
                     break;
                 case UnderlineStyle::DoublyUnderlined:
-                    fmt::format_to(std::back_inserter(contentBuilder), FMT_COMPILE("\\uldb\\ulc{}"), ulIdx);
+                    fmt::format_to(std::back_inserter(groupBuilder), FMT_COMPILE("\\uldb\\ulc{}"), ulIdx);
                     break;
                 case UnderlineStyle::CurlyUnderlined:
-                    fmt::format_to(std::back_inserter(contentBuilder), FMT_COMPILE("\\ulwave\\ulc{}"), ulIdx);
+                    fmt::format_to(std::back_inserter(groupBuilder), FMT_COMPILE("\\ulwave\\ulc{}"), ulIdx);
                     break;
                 case UnderlineStyle::DottedUnderlined:
-                    fmt::format_to(std::back_inserter(contentBuilder), FMT_COMPILE("\\uld\\ulc{}"), ulIdx);
+                    fmt::format_to(std::back_inserter(groupBuilder), FMT_COMPILE("\\uld\\ulc{}"), ulIdx);
                     break;
                 case UnderlineStyle::DashedUnderlined:
-                    fmt::format_to(std::back_inserter(contentBuilder), FMT_COMPILE("\\uldash\\ulc{}"), ulIdx);
+                    fmt::format_to(std::back_inserter(groupBuilder), FMT_COMPILE("\\uldash\\ulc{}"), ulIdx);
                     break;
                 case UnderlineStyle::SinglyUnderlined:
                 default:
-                    fmt::format_to(std::back_inserter(contentBuilder), FMT_COMPILE("\\ul\\ulc{}"), ulIdx);
+                    fmt::format_to(std::back_inserter(groupBuilder), FMT_COMPILE("\\ul\\ulc{}"), ulIdx);
                     break;
                 }
 
                 // RTF commands and the text data must be separated by a space.
                 // Otherwise, if the text begins with a space then that space will
                 // be interpreted as part of the last command, and will be lost.
-                contentBuilder += " ";
+                groupBuilder += " ";
+
+                // Attributes that differ in ways that aren't visible in RTF (e.g. hyperlink IDs or
+                // palette indices that map to the same color) produce identical groups. We coalesce those.
+                if (groupBuilder != openGroup)
+                {
+                    if (!openGroup.empty())
+                    {
+                        contentBuilder += "}"; // close RTF group
+                    }
+                    contentBuilder += groupBuilder;
+                    std::swap(openGroup, groupBuilder);
+                }
 
                 const auto unescapedText = row.GetText(x, nextX); // including character at nextX
                 _AppendRTFText(contentBuilder, unescapedText);
 
-                contentBuilder += "}"; // close RTF group
-
                 // advance to next run of text
                 x = nextX;
             }
 
+            if (!openGroup.empty())
+            {
+                contentBuilder += "}"; // close RTF group
+                openGroup.clear();
+            }
+
             // never add line break to the last row.
             if (addLineBreak && iRow < req.end.y)
             {
@@ -2308,10 +2595,12 @@ std::string TextBuffer::GenRTF(const CopyRequest& req,
         }
 
         // add color table to the final RTF
-        rtfBuilder += colorTableBuilder + "}";
+        rtfBuilder += colorTableBuilder;
+        rtfBuilder += "}";
 
         // add the text content to the final RTF
-        rtfBuilder += contentBuilder + "}";
+        rtfBuilder += contentBuilder;
+        rtfBuilder += "}";
 
         return rtfBuilder;
     }
@@ -2365,6 +2654,10 @@ void TextBuffer::Serialize(const wchar_t* destination) const
     TextColor previousUl;
     uint16_t previousHyperlinkId = 0;
     bool delayedLineBreak = false;
+    // All SGR parameters of a run are collected here and then written out as a single escape sequence.
+    // Each parameter is followed by a ";". Compared to one sequence per parameter this roughly halves
+    // the amount of sequences ControlCore::RestoreFromPath() needs to parse when restoring a session.
+    std::wstring sgr;
 
     // This iterates through each row. The exit condition is at the end
     // of the for() loop so that we can properly handle file flushing.
@@ -2399,6 +2692,8 @@ void TextBuffer::Serialize(const wchar_t* destination) const
             const auto bg = it->value.GetBackground();
             const auto ul = it->value.GetUnderlineColor();
 
+            sgr.clear();
+
             if (previousAttr != attr)
             {
                 auto attrDelta = attr ^ previousAttr;
@@ -2413,18 +2708,13 @@ void TextBuffer::Serialize(const wchar_t* destination) const
                 if (WI_AreAllFlagsSet(previousAttr, CharacterAttributes::Intense | CharacterAttributes::Faint) &&
                     WI_IsAnyFlagSet(attrDelta, CharacterAttributes::Intense | CharacterAttributes::Faint))
                 {
-                    wchar_t buf[8] = L"\x1b[22m";
-                    size_t len = 5;
+                    sgr.append(L"22;");
 
                     if (WI_IsAnyFlagSet(attr, CharacterAttributes::Intense | CharacterAttributes::Faint))
                     {
-                        buf[4] = L';';
-                        buf[5] = WI_IsAnyFlagSet(attr, CharacterAttributes::Intense) ? L'1' : L'2';
-                        buf[6] = L'm';
-                        len = 7;
+                        sgr.append(WI_IsAnyFlagSet(attr, CharacterAttributes::Intense) ? L"1;" : L"2;");
                     }
 
-                    buffer.append(&buf[0], len);
                     WI_ClearAllFlags(attrDelta, CharacterAttributes::Intense | CharacterAttributes::Faint);
                 }
 
@@ -2449,7 +2739,7 @@ void TextBuffer::Serialize(const wchar_t* destination) const
                         if (WI_IsAnyFlagSet(attrDelta, mapping.attr))
                         {
                             const auto n = til::at(mapping.change, WI_IsAnyFlagSet(attr, mapping.attr));
-                            fmt::format_to(std::back_inserter(buffer), FMT_COMPILE(L"\x1b[{}m"), n);
+                            fmt::format_to(std::back_inserter(sgr), FMT_COMPILE(L"{};"), n);
                         }
                     }
                 }
@@ -2457,12 +2747,12 @@ void TextBuffer::Serialize(const wchar_t* destination) const
                 if (WI_IsAnyFlagSet(attrDelta, CharacterAttributes::UnderlineStyle))
                 {
                     static constexpr std::wstring_view mappings[] = {
-                        L"\x1b[24m", // UnderlineStyle::NoUnderline
-                        L"\x1b[4m", // UnderlineStyle::SinglyUnderlined
-                        L"\x1b[21m", // UnderlineStyle::DoublyUnderlined
-                        L"\x1b[4:3m", // UnderlineStyle::CurlyUnderlined
-                        L"\x1b[4:4m", // UnderlineStyle::DottedUnderlined
-                        L"\x1b[4:5m", // UnderlineStyle::DashedUnderlined
+                        L"24;", // UnderlineStyle::NoUnderline
+                        L"4;", // UnderlineStyle::SinglyUnderlined
+                        L"21;", // UnderlineStyle::DoublyUnderlined
+                        L"4:3;", // UnderlineStyle::CurlyUnderlined
+                        L"4:4;", // UnderlineStyle::DottedUnderlined
+                        L"4:5;", // UnderlineStyle::DashedUnderlined
                     };
 
                     auto idx = WI_EnumValue(it->value.GetUnderlineStyle());
@@ -2471,7 +2761,7 @@ void TextBuffer::Serialize(const wchar_t* destination) const
                         idx = 1; // UnderlineStyle::SinglyUnderlined
                     }
 
-                    buffer.append(til::at(mappings, idx));
+                    sgr.append(til::at(mappings, idx));
                 }
 
                 previousAttr = attr;
@@ -2482,20 +2772,20 @@ void TextBuffer::Serialize(const wchar_t* destination) const
                 switch (fg.GetType())
                 {
                 case ColorType::IsDefault:
-                    buffer.append(L"\x1b[39m");
+                    sgr.append(L"39;");
                     break;
                 case ColorType::IsIndex16:
                 {
                     uint8_t index = WI_IsFlagSet(fg.GetIndex(), 8) ? 90 : 30;
                     index += fg.GetIndex() & 7;
-                    fmt::format_to(std::back_inserter(buffer), FMT_COMPILE(L"\x1b[{}m"), index);
+                    fmt::format_to(std::back_inserter(sgr), FMT_COMPILE(L"{};"), index);
                     break;
                 }
                 case ColorType::IsIndex256:
-                    fmt::format_to(std::back_inserter(buffer), FMT_COMPILE(L"\x1b[38;5;{}m"), fg.GetIndex());
+                    fmt::format_to(std::back_inserter(sgr), FMT_COMPILE(L"38;5;{};"), fg.GetIndex());
                     break;
                 case ColorType::IsRgb:
-                    fmt::format_to(std::back_inserter(buffer), FMT_COMPILE(L"\x1b[38;2;{};{};{}m"), fg.GetR(), fg.GetG(), fg.GetB());
+                    fmt::format_to(std::back_inserter(sgr), FMT_COMPILE(L"38;2;{};{};{};"), fg.GetR(), fg.GetG(), fg.GetB());
                     break;
                 default:
                     break;
@@ -2508,20 +2798,20 @@ void TextBuffer::Serialize(const wchar_t* destination) const
                 switch (bg.GetType())
                 {
                 case ColorType::IsDefault:
-                    buffer.append(L"\x1b[49m");
+                    sgr.append(L"49;");
                     break;
                 case ColorType::IsIndex16:
                 {
                     uint8_t index = WI_IsFlagSet(bg.GetIndex(), 8) ? 100 : 40;
                     index += bg.GetIndex() & 7;
-                    fmt::format_to(std::back_inserter(buffer), FMT_COMPILE(L"\x1b[{}m"), index);
+                    fmt::format_to(std::back_inserter(sgr), FMT_COMPILE(L"{};"), index);
                     break;
                 }
                 case ColorType::IsIndex256:
-                    fmt::format_to(std::back_inserter(buffer), FMT_COMPILE(L"\x1b[48;5;{}m"), bg.GetIndex());
+                    fmt::format_to(std::back_inserter(sgr), FMT_COMPILE(L"48;5;{};"), bg.GetIndex());
                     break;
                 case ColorType::IsRgb:
-                    fmt::format_to(std::back_inserter(buffer), FMT_COMPILE(L"\x1b[48;2;{};{};{}m"), bg.GetR(), bg.GetG(), bg.GetB());
+                    fmt::format_to(std::back_inserter(sgr), FMT_COMPILE(L"48;2;{};{};{};"), bg.GetR(), bg.GetG(), bg.GetB());
                     break;
                 default:
                     break;
@@ -2531,16 +2821,16 @@ void TextBuffer::Serialize(const wchar_t* destination) const
 
             if (previousUl != ul)
             {
-                switch (fg.GetType())
+                switch (ul.GetType())
                 {
                 case ColorType::IsDefault:
-                    buffer.append(L"\x1b[59m");
+                    sgr.append(L"59;");
                     break;
                 case ColorType::IsIndex256:
-                    fmt::format_to(std::back_inserter(buffer), FMT_COMPILE(L"\x1b[58:5:{}m"), ul.GetIndex());
+                    fmt::format_to(std::back_inserter(sgr), FMT_COMPILE(L"58:5:{};"), ul.GetIndex());
                     break;
                 case ColorType::IsRgb:
-                    fmt::format_to(std::back_inserter(buffer), FMT_COMPILE(L"\x1b[58:2::{}:{}:{}m"), ul.GetR(), ul.GetG(), ul.GetB());
+                    fmt::format_to(std::back_inserter(sgr), FMT_COMPILE(L"58:2::{}:{}:{};"), ul.GetR(), ul.GetG(), ul.GetB());
                     break;
                 default:
                     break;
@@ -2548,6 +2838,14 @@ void TextBuffer::Serialize(const wchar_t* destination) const
                 previousUl = ul;
             }
 
+            if (!sgr.empty())
+            {
+                // Replace the trailing ";" with the final "m".
+                sgr.back() = L'm';
+                buffer.append(L"\x1b[");
+                buffer.append(sgr);
+            }
+
             if (previousHyperlinkId != hyperlinkId)
             {
                 if (hyperlinkId)
@@ -2807,8 +3105,17 @@ void TextBuffer::Reflow(TextBuffer& oldBuffer, TextBuffer& newBuffer, const View
 
             const auto& oldAttr = oldRow.Attributes();
             auto& newAttr = newRow.Attributes();
-            const auto attributes = oldAttr.slice(gsl::narrow_cast<uint16_t>(oldX), oldAttr.size());
-            newAttr.replace(gsl::narrow_cast<uint16_t>(newX), newAttr.size(), attributes);
+            // Most rows are copied starting at their first column, in which case we can skip
+            // the slice() and the temporary run list it allocates. This adds up for large buffers.
+            if (oldX == 0)
+            {
+                newAttr.replace(gsl::narrow_cast<uint16_t>(newX), newAttr.size(), oldAttr);
+            }
+            else
+            {
+                const auto attributes = oldAttr.slice(gsl::narrow_cast<uint16_t>(oldX), oldAttr.size());
+                newAttr.replace(gsl::narrow_cast<uint16_t>(newX), newAttr.size(), attributes);
+            }
             newAttr.resize_trailing_extent(newWidthU16);
 
             if (oldY == oldCursorPos.y && oldCursorPos.x >= oldX)
@@ -2941,6 +3248,8 @@ uint16_t TextBuffer::GetHyperlinkId(std::wstring_view uri, std::wstring_view id)
         }
         numericId = (*(result.first)).second;
     }
+    // Only the first time an ID is handed out matters to _PruneHyperlinks().
+    _hyperlinkRevisions.emplace(numericId, _lastMutationId);
     // _currentHyperlinkId could overflow, make sure its not 0
     if (_currentHyperlinkId == 0)
     {
@@ -2957,6 +3266,7 @@ uint16_t TextBuffer::GetHyperlinkId(std::wstring_view uri, std::wstring_view id)
 void TextBuffer::RemoveHyperlinkFromMap(uint16_t id) noexcept
 {
     _hyperlinkMap.erase(id);
+    _hyperlinkRevisions.erase(id);
     for (const auto& customIdPair : _hyperlinkCustomIdMap)
     {
         if (customIdPair.second == id)
@@ -3002,7 +3312,113 @@ void TextBuffer::CopyHyperlinkMaps(const TextBuffer& other)
 // The end coordinates of the returned ranges are considered inclusive.
 std::optional<std::vector<til::point_span>> TextBuffer::SearchText(const std::wstring_view& needle, SearchFlag flags) const
 {
-    return SearchText(needle, flags, 0, til::CoordTypeMax);
+    // Searching a large buffer can take a while and happens while the console lock is held.
+    // A literal needle without line breaks can't match across logical lines (= rows joined by
+    // WasWrapForced()), so we can split the buffer at logical line boundaries and search the
+    // chunks concurrently without changing the results. This isn't true for regular expressions.
+    // Searching the default 9001 rows of scrollback is fast enough that handing off to other threads
+    // doesn't pay for itself, which is why only considerably larger buffers are split up.
+    static constexpr til::CoordType minRowsPerChunk = 16384;
+    static constexpr size_t maxChunks = 8;
+
+    const auto rowEnd = _estimateOffsetOfLastCommittedRow() + 1;
+    const auto literal = WI_IsFlagClear(flags, SearchFlag::RegularExpression) && needle.find_first_of(L"\r\n") == std::wstring_view::npos;
+    const auto chunks = std::min({ maxChunks, static_cast<size_t>(std::thread::hardware_concurrency()), gsl::narrow_cast<size_t>(rowEnd / minRowsPerChunk) });
+
+    if (!literal || chunks < 2)
+    {
+        return SearchText(needle, flags, 0, rowEnd);
+    }
+
+    // Chunk i covers [boundaries[i], boundaries[i+1]).
+    til::small_vector<til::CoordType, maxChunks + 1> boundaries;
+    boundaries.push_back(0);
+    for (size_t i = 1; i < chunks; ++i)
+    {
+        auto y = std::max(boundaries.back(), gsl::narrow_cast<til::CoordType>(rowEnd * i / chunks));
+        while (y < rowEnd && GetRowByOffset(y - 1).WasWrapForced())
+        {
+            ++y;
+        }
+        boundaries.push_back(y);
+    }
+    boundaries.push_back(rowEnd);
+
+    struct Chunk
+    {
+        const TextBuffer* buffer = nullptr;
+        std::wstring_view needle;
+        SearchFlag flags{};
+        til::CoordType beg = 0;
+        til::CoordType end = 0;
+        til::latch* done = nullptr;
+        std::optional<std::vector<til::point_span>> results;
+        std::exception_ptr exception;
+
+        void run() noexcept
+        {
+            try
+            {
+                results = buffer->SearchText(needle, flags, beg, end);
+            }
+            catch (...)
+            {
+                exception = std::current_exception();
+            }
+        }
+    };
+
+    // SearchText() only ever reads from already committed rows, which makes it safe
+    // to call concurrently, as long as the caller holds the lock for the whole duration.
+    // The chunks run on the process' default threadpool, which keeps its threads around between
+    // searches, so that typing into the search box doesn't spawn new threads on every keystroke.
+    til::latch done{ gsl::narrow_cast<ptrdiff_t>(chunks - 1) };
+    std::array<Chunk, maxChunks> work;
+    for (size_t i = 0; i < chunks; ++i)
+    {
+        til::at(work, i) = { this, needle, flags, til::at(boundaries, i), til::at(boundaries, i + 1), &done };
+    }
+
+    for (size_t i = 1; i < chunks; ++i)
+    {
+        auto& chunk = til::at(work, i);
+        const auto submitted = TrySubmitThreadpoolCallback(
+            [](PTP_CALLBACK_INSTANCE, PVOID context) noexcept {
+                const auto chunk = static_cast<Chunk*>(context);
+                chunk->run();
+                chunk->done->count_down();
+            },
+            &chunk,
+            nullptr);
+        if (!submitted)
+        {
+            chunk.run();
+            done.count_down();
+        }
+    }
+
+    work[0].run();
+    done.wait();
+
+    for (size_t i = 0; i < chunks; ++i)
+    {
+        if (const auto& exception = til::at(work, i).exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+
+    auto& results = work[0].results;
+    for (size_t i = 1; i < chunks && results; ++i)
+    {
+        const auto& chunk = til::at(work, i).results;
+        if (!chunk)
+        {
+            return std::nullopt;
+        }
+        results->insert(results->end(), chunk->begin(), chunk->end());
+    }
+    return std::move(results);
 }
 
 // Searches through the given rows [rowBeg,rowEnd) for `needle` and returns the coordinates in absolute coordinates.
@@ -3020,8 +3436,6 @@ std::optional<std::vector<til::point_span>> TextBuffer::SearchText(const std::ws
         return results;
     }
 
-    auto text = ICU::UTextFromTextBuffer(*this, rowBeg, rowEnd);
-
     uint32_t icuFlags{ 0 };
     WI_SetFlagIf(icuFlags, UREGEX_CASE_INSENSITIVE, WI_IsFlagSet(flags, SearchFlag::CaseInsensitive));
 
@@ -3035,20 +3449,83 @@ std::optional<std::vector<til::point_span>> TextBuffer::SearchText(const std::ws
     }
 
     UErrorCode status = U_ZERO_ERROR;
-    const auto re = ICU::CreateRegex(needle, icuFlags, &status);
+    const auto re = ICU::InternRegex(needle, icuFlags, &status);
     if (status > U_ZERO_ERROR)
     {
         return std::nullopt;
     }
 
-    uregex_setUText(re.get(), &text, &status);
+    const auto searchRows = [&](til::CoordType beg, til::CoordType end) {
+        auto text = ICU::UTextFromTextBuffer(*this, beg, end);
+        uregex_setUText(re.get(), &text, &status);
+
+        if (uregex_find(re.get(), -1, &status))
+        {
+            do
+            {
+                results.emplace_back(ICU::BufferRangeFromMatch(&text, re.get()));
+            } while (uregex_findNext(re.get(), &status));
+        }
+    };
 
-    if (uregex_find(re.get(), -1, &status))
+    // Going through ICU's UText callbacks is slow compared to a plain wstring_view::find().
+    // A case-sensitive literal without line breaks can only match within a logical line
+    // (= rows joined by WasWrapForced()), so we can cheaply look for the needle in each of
+    // them first and only run ICU over the lines that actually contain it.
+    // Case-insensitive searches can't do this, because ICU applies full Unicode case folding.
+    if (WI_AreAllFlagsClear(flags, SearchFlag::RegularExpression | SearchFlag::CaseInsensitive) &&
+        needle.find_first_of(L"\r\n") == std::wstring_view::npos)
     {
-        do
+        std::wstring line;
+        auto candidateBeg = rowBeg;
+        auto candidateEnd = rowBeg;
+
+        for (auto y = rowBeg; y < rowEnd;)
         {
-            results.emplace_back(ICU::BufferRangeFromMatch(&text, re.get()));
-        } while (uregex_findNext(re.get(), &status));
+            const auto lineBeg = y;
+            const auto& row = GetRowByOffset(y++);
+            std::wstring_view text = row.GetText();
+
+            if (row.WasWrapForced() && y < rowEnd)
+            {
+                line.assign(text);
+                for (;;)
+                {
+                    const auto& next = GetRowByOffset(y++);
+                    line.append(next.GetText());
+                    if (!next.WasWrapForced() || y >= rowEnd)
+                    {
+                        break;
+                    }
+                }
+                text = line;
+            }
+
+            if (text.find(needle) == std::wstring_view::npos)
+            {
+                continue;
+            }
+
+            // Merge adjacent lines into a single ICU search.
+            if (lineBeg != candidateEnd)
+            {
+                if (candidateBeg != candidateEnd)
+                {
+                    searchRows(candidateBeg, candidateEnd);
+                }
+                candidateBeg = lineBeg;
+            }
+            candidateEnd = y;
+        }
+
+        if (candidateBeg != candidateEnd)
+        {
+            searchRows(candidateBeg, candidateEnd);
+        }
+    }
+    else
+    {
+        searchRows(rowBeg, rowEnd);
     }
 
     return results;
@@ -3058,18 +3535,47 @@ std::optional<std::vector<til::point_span>> TextBuffer::SearchText(const std::ws
 // This is what should be used for hot paths, like updating the scrollbar.
 std::vector<ScrollMark> TextBuffer::GetMarkRows() const
 {
-    std::vector<ScrollMark> marks;
+    return _updateMarkRows();
+}
+
+// Brings _markRows up to date and returns it. The scrollbar and the mark navigation call into this
+// after pretty much every bit of output, so instead of scanning every row each time, we use
+// GetDirtyRows() to find the first row modified since the last call and only rescan from there on.
+// It starts its search at a lowest-dirty-row watermark, so the clean rows above aren't visited either.
+const std::vector<ScrollMark>& TextBuffer::_updateMarkRows() const
+{
     const auto bottom = _estimateOffsetOfLastCommittedRow();
-    for (auto y = 0; y <= bottom; y++)
+    til::CoordType y = 0;
+
+    if (const auto dirty = GetDirtyRows(_markRowsRevision))
+    {
+        // Drop the marks that scrolled out of the buffer or that are in rows we're about to rescan.
+        std::erase_if(_markRows, [&](const ScrollMark& mark) {
+            return mark.row < dirty->scrolled || mark.row - dirty->scrolled >= dirty->begin;
+        });
+        for (auto& mark : _markRows)
+        {
+            mark.row -= dirty->scrolled;
+        }
+        y = dirty->begin;
+    }
+    else
+    {
+        _markRows.clear();
+    }
+
+    for (; y <= bottom; y++)
     {
         const auto& row = GetRowByOffset(y);
         const auto& data{ row.GetScrollbarData() };
         if (data.has_value())
         {
-            marks.emplace_back(y, *data);
+            _markRows.emplace_back(y, *data);
         }
     }
-    return marks;
+
+    _markRowsRevision = GetRevisionCursor();
+    return _markRows;
 }
 
 // Get all the regions for all the shell integration marks in the buffer.
@@ -3088,17 +3594,13 @@ std::vector<MarkExtents> TextBuffer::GetMarkExtents(size_t limit) const
     }
 
     std::vector<MarkExtents> marks{};
-    const auto bottom = _estimateOffsetOfLastCommittedRow();
-    auto lastPromptY = bottom;
-    for (auto promptY = bottom; promptY >= 0; promptY--)
+    const auto& markRows = _updateMarkRows();
+    auto lastPromptY = _estimateOffsetOfLastCommittedRow();
+    // Only rows that started a prompt have scrollbar data, so we don't need to look at any others.
+    for (auto it = markRows.rbegin(); it != markRows.rend(); ++it)
     {
-        const auto& currRow = GetRowByOffset(promptY);
-        auto& rowPromptData = currRow.GetScrollbarData();
-        if (!rowPromptData.has_value())
-        {
-            // This row didn't start a prompt, don't even look here.
-            continue;
-        }
+        const auto promptY = it->row;
+        const auto& rowPromptData = it->data;
 
         // Future thought! In #11000 & #14792, we considered the possibility of
         // scrolling to only an error mark, or something like that. Perhaps in
@@ -3108,7 +3610,7 @@ std::vector<MarkExtents> TextBuffer::GetMarkExtents(size_t limit) const
         // For now, skip any "Default" marks, since those came from the UI. We
         // just want the ones that correspond to shell integration.
 
-        if (rowPromptData->category == MarkCategory::Default)
+        if (rowPromptData.category == MarkCategory::Default)
         {
             continue;
         }
@@ -3317,39 +3819,32 @@ std::wstring TextBuffer::_commandForRow(const til::CoordType rowOffset,
 
 std::wstring TextBuffer::CurrentCommand() const
 {
-    auto promptY = GetCursor().GetPosition().y;
-    for (; promptY >= 0; promptY--)
+    // Find the last row at or above the cursor that started a prompt. _updateMarkRows() is sorted by row.
+    const auto& markRows = _updateMarkRows();
+    const auto cursorY = GetCursor().GetPosition().y;
+    const auto it = std::upper_bound(markRows.begin(), markRows.end(), cursorY, [](const auto y, const ScrollMark& mark) {
+        return y < mark.row;
+    });
+    if (it == markRows.begin())
     {
-        const auto& currRow = GetRowByOffset(promptY);
-        auto& rowPromptData = currRow.GetScrollbarData();
-        if (!rowPromptData.has_value())
-        {
-            // This row didn't start a prompt, don't even look here.
-            continue;
-        }
-
-        // This row did start a prompt! Find the prompt that starts here.
-        // Presumably, no rows below us will have prompts, so pass in the last
-        // row with text as the bottom
-        return _commandForRow(promptY, _estimateOffsetOfLastCommittedRow(), true);
+        return L"";
     }
-    return L"";
+
+    // This row did start a prompt! Find the prompt that starts here.
+    // Presumably, no rows below us will have prompts, so pass in the last
+    // row with text as the bottom
+    return _commandForRow(std::prev(it)->row, _estimateOffsetOfLastCommittedRow(), true);
 }
 
 std::vector<std::wstring> TextBuffer::Commands() const
 {
     std::vector<std::wstring> commands{};
-    const auto bottom = _estimateOffsetOfLastCommittedRow();
-    auto lastPromptY = bottom;
-    for (auto promptY = bottom; promptY >= 0; promptY--)
+    const auto& markRows = _updateMarkRows();
+    auto lastPromptY = _estimateOffsetOfLastCommittedRow();
+    // Only rows that started a prompt have scrollbar data, so we don't need to look at any others.
+    for (auto it = markRows.rbegin(); it != markRows.rend(); ++it)
     {
-        const auto& currRow = GetRowByOffset(promptY);
-        auto& rowPromptData = currRow.GetScrollbarData();
-        if (!rowPromptData.has_value())
-        {
-            // This row didn't start a prompt, don't even look here.
-            continue;
-        }
+        const auto promptY = it->row;
 
         // This row did start a prompt! Find the prompt that starts here.
         // Presumably, no rows below us will have prompts, so pass in the last
@@ -132,10 +132,29 @@ public:
     uint64_t GetLastMutationId() const noexcept;
     const til::CoordType GetFirstRowIndex() const noexcept;
 
+    struct RevisionCursor
+    {
+        uint64_t mutationId{ 0 };
+        uint64_t scrollCount{ 0 };
+    };
+
+    struct DirtyRows
+    {
+        // The number of rows IncrementCircularBuffer() scrolled the contents up by.
+        til::CoordType scrolled{ 0 };
+        // The first row whose ROW::GetRevision() is newer than the cursor.
+        // If no row was modified, this is the row past the last committed one.
+        til::CoordType begin{ 0 };
+    };
+
+    RevisionCursor GetRevisionCursor() const noexcept;
+    std::optional<DirtyRows> GetDirtyRows(const RevisionCursor& cursor) const;
+
     const Microsoft::Console::Types::Viewport GetSize() const noexcept;
 
     void ScrollRows(const til::CoordType firstRow, const til::CoordType size, const til::CoordType delta);
     void CopyRow(const til::CoordType srcRow, const til::CoordType dstRow, TextBuffer& dstBuffer) const;
+    void CopyRowSegment(const til::CoordType srcRow, const til::CoordType srcColumn, const til::CoordType dstRow, const til::CoordType dstColumn, const til::CoordType width);
 
     til::CoordType TotalRowCount() const noexcept;
 
@@ -311,6 +330,7 @@ private:
     void _reserve(til::size screenBufferSize, const TextAttribute& defaultAttributes);
     void _commit(const std::byte* row);
     void _decommit() noexcept;
+    void _decommitFrom(std::byte* row) noexcept;
     void _construct(const std::byte* until) noexcept;
     void _destroy() const noexcept;
     ROW& _getRowByOffsetDirect(size_t offset);
@@ -318,8 +338,10 @@ private:
     til::CoordType _estimateOffsetOfLastCommittedRow() const noexcept;
 
     void _SetFirstRowIndex(const til::CoordType FirstRowIndex) noexcept;
+    void _invalidateDirtyRows() noexcept;
     void _ExpandTextRow(til::inclusive_rect& selectionRow) const;
     DelimiterClass _GetDelimiterClassAt(const til::point pos, const std::wstring_view wordDelimiters) const;
+    til::CoordType _GetScreenTextEnd(const til::CoordType y) const;
     til::point _GetWordStartForAccessibility(const til::point target, const std::wstring_view wordDelimiters) const;
     til::point _GetWordStartForSelection(const til::point target, const std::wstring_view wordDelimiters) const;
     til::point _GetWordEndForAccessibility(const til::point target, const std::wstring_view wordDelimiters, const til::point limit) const;
@@ -328,6 +350,7 @@ private:
 
     std::wstring _commandForRow(const til::CoordType rowOffset, const til::CoordType bottomInclusive, const bool clipAtCursor = false) const;
     MarkExtents _scrollMarkExtentForRow(const til::CoordType rowOffset, const til::CoordType bottomInclusive) const;
+    const std::vector<ScrollMark>& _updateMarkRows() const;
     bool _createPromptMarkIfNeeded();
 
     std::tuple<til::CoordType, til::CoordType, bool> _RowCopyHelper(const CopyRequest& req, const til::CoordType iRow, const ROW& row) const;
@@ -338,6 +361,9 @@ private:
 
     std::unordered_map<uint16_t, std::wstring> _hyperlinkMap;
     std::unordered_map<std::wstring, uint16_t> _hyperlinkCustomIdMap;
+    // The _lastMutationId at which each hyperlink ID was handed out by GetHyperlinkId().
+    // Rows with an older revision can't contain that ID, which allows _PruneHyperlinks() to skip them.
+    std::unordered_map<uint16_t, uint64_t> _hyperlinkRevisions;
     uint16_t _currentHyperlinkId = 1;
 
     // This block describes the state of the underlying virtual memory buffer that holds all ROWs, text and attributes.
@@ -380,6 +406,10 @@ private:
     // There's probably a better metric than this. (This comment was written when ROW had both,
     // a _chars array containing text and a _charOffsets array contain column-to-text indices.)
     static constexpr size_t _commitReadAheadRowCount = 128;
+    // Rows that have scrolled this far up from the bottom of the buffer are considered "cold"
+    // and get ROW::Compact()ed once by IncrementCircularBuffer(). It's a few screens worth of
+    // rows, so that anything an application is still likely to rewrite stays untouched.
+    static constexpr til::CoordType _compactRowDistance = 256;
     // Before TextBuffer was made to use virtual memory it initialized the entire memory arena with the initial
     // attributes right away. To ensure it continues to work the way it used to, this stores these initial attributes.
     TextAttribute _initialAttributes;
@@ -400,6 +430,25 @@ private:
     TextAttribute _currentAttributes;
     til::CoordType _firstRow = 0; // indexes top row (not necessarily 0)
     uint64_t _lastMutationId = 0;
+    // The _lastMutationId at which rows were last moved around other than by IncrementCircularBuffer(),
+    // e.g. by a resize. Revisions from before this point can't be compared anymore. See GetDirtyRows().
+    uint64_t _rowsMovedMutationId = 0;
+    // The number of times IncrementCircularBuffer() was called. See GetDirtyRows().
+    uint64_t _scrollCount = 0;
+    // Lowest-dirty-row watermarks, so that GetDirtyRows() doesn't need to walk past all the clean rows at the top.
+    // GetRevisionCursor() starts a new generation and only the newest one is updated when a row is modified.
+    // A generation thus holds the lowest row that was modified between its mutationId and that of the next one.
+    struct DirtyWatermark
+    {
+        uint64_t mutationId = UINT64_MAX;
+        til::CoordType row = til::CoordTypeMax;
+    };
+    mutable std::array<DirtyWatermark, 8> _dirtyWatermarks;
+    mutable size_t _dirtyWatermarkHead = 0;
+
+    // The rows with scrollbar data as of _markRowsRevision. See _updateMarkRows().
+    mutable std::vector<ScrollMark> _markRows;
+    mutable RevisionCursor _markRowsRevision;
 
     Cursor _cursor;
     bool _isActiveBuffer = false;
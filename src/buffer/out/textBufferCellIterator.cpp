@@ -116,6 +116,8 @@ TextBufferCellIterator& TextBufferCellIterator::operator+=(const ptrdiff_t& move
     // of a new OutputCellView(). This has a high performance impact (ICache spill?).
     // The code below inlines _bounds.IncrementInBounds as well as SetPos.
     // In the hot path (_pos.y doesn't change) we modify the _view directly.
+    // Instead of stepping cell by cell, the new position is computed directly,
+    // so that large movements (e.g. skipping an entire row) cost O(1).
 
     // Hoist these integers which will be used frequently later.
     const auto boundsRightInclusive = _bounds.RightInclusive();
@@ -130,25 +132,26 @@ TextBufferCellIterator& TextBufferCellIterator::operator+=(const ptrdiff_t& move
     auto newX = oldX;
     auto newY = oldY;
 
-    while (move > 0)
+    if (move > 0)
     {
-        if (newX == boundsRightInclusive)
+        if (move <= boundsRightInclusive - oldX)
         {
-            newX = boundsLeft;
-            newY++;
-            if (newY > boundsBottomInclusive)
-            {
-                newY = boundsTop;
-                _exceeded = true;
-                break;
-            }
+            newX = gsl::narrow_cast<til::CoordType>(oldX + move);
         }
         else
         {
-            newX++;
-            _exceeded = false;
+            const ptrdiff_t width = boundsRightInclusive - boundsLeft + 1;
+            const ptrdiff_t total = width * (boundsBottomInclusive - boundsTop + 1);
+            const auto offset = (oldY - boundsTop) * width + (oldX - boundsLeft) + move;
+            if (offset >= total)
+            {
+                _exceeded = true;
+                return *this;
+            }
+            newX = gsl::narrow_cast<til::CoordType>(boundsLeft + offset % width);
+            newY = gsl::narrow_cast<til::CoordType>(boundsTop + offset / width);
         }
-        move--;
+        _exceeded = false;
     }
 
     if (_exceeded)
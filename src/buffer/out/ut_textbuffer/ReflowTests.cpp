@@ -805,6 +805,56 @@ class ReflowTests
             _compareTextBufferAgainstTestBuffer(*textBuffer, testBuffer);
         }
     }
+
+    TEST_METHOD(ReflowPerformance)
+    {
+        BEGIN_TEST_METHOD_PROPERTIES()
+            TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        END_TEST_METHOD_PROPERTIES()
+
+        static constexpr til::CoordType width = 120;
+        static constexpr TextAttribute attr1{ 0x7 };
+        static constexpr TextAttribute attr2{ 0x2 };
+
+        // A line of text that is a bit shorter than the buffer is wide, so that
+        // shrinking the buffer wraps it and widening it unwraps it again.
+        std::wstring line;
+        for (til::CoordType i = 0; i < width - 8; ++i)
+        {
+            line.push_back(static_cast<wchar_t>(L'a' + i % 26));
+        }
+
+        for (const til::CoordType height : { 1000, 9001, 32767 })
+        {
+            auto textBuffer = std::make_unique<TextBuffer>(til::size{ width, height }, attr1, 0, false, &renderer);
+
+            // Fill the buffer with text and a few attribute runs per row, like a colored log.
+            for (til::CoordType y = 0; y < height; ++y)
+            {
+                RowWriteState state{
+                    .text = line,
+                    .columnLimit = width,
+                };
+                textBuffer->Replace(y, attr1, state);
+                textBuffer->GetMutableRowByOffset(y).ReplaceAttributes(8, 16, attr2);
+            }
+            textBuffer->GetCursor().SetPosition({ 0, height - 1 });
+
+            static constexpr int iterations = 4;
+            const auto beg = std::chrono::steady_clock::now();
+
+            for (int i = 0; i < iterations; ++i)
+            {
+                // Alternate between a narrower and the original width, like dragging the window edge back and forth.
+                const til::size newSize{ (i & 1) ? width : width - 16, height };
+                auto newBuffer = _textBufferByReflowingTextBuffer(*textBuffer, newSize);
+                std::swap(textBuffer, newBuffer);
+            }
+
+            const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - beg).count();
+            Log::Comment(NoThrowString().Format(L"%dx%d: %.3f ms per reflow", width, height, elapsed / iterations));
+        }
+    }
 };
 
 DummyRenderer ReflowTests::renderer{};
@@ -61,4 +61,33 @@ class UTextAdapterTests
         actual = buffer.SearchText(L"ネコ", SearchFlag::None);
         VERIFY_ARE_EQUAL(expected, actual);
     }
+
+    TEST_METHOD(CaseSensitiveAcrossWrappedRows)
+    {
+        DummyRenderer renderer;
+        TextBuffer buffer{ til::size{ 4, 4 }, TextAttribute{}, 0, false, &renderer };
+
+        static constexpr std::array<std::wstring_view, 4> rows{ L"abcd", L"efab", L"zzzz", L"cdab" };
+        for (til::CoordType y = 0; y < 4; y++)
+        {
+            RowWriteState state{ .text = til::at(rows, y) };
+            buffer.Replace(y, TextAttribute{}, state);
+        }
+        buffer.SetWrapForced(0, true);
+
+        // Case-sensitive literals are pre-filtered per logical line. The results must be identical
+        // to those of a case-insensitive search, which runs ICU over the entire buffer.
+        auto expected = std::vector<til::point_span>{ { { 3, 0 }, { 0, 1 } } };
+        auto actual = buffer.SearchText(L"de", SearchFlag::None);
+        VERIFY_ARE_EQUAL(expected, actual);
+        VERIFY_ARE_EQUAL(buffer.SearchText(L"de", SearchFlag::CaseInsensitive), actual);
+
+        expected = std::vector<til::point_span>{ { { 0, 0 }, { 1, 0 } }, { { 2, 1 }, { 3, 1 } }, { { 2, 3 }, { 3, 3 } } };
+        actual = buffer.SearchText(L"ab", SearchFlag::None);
+        VERIFY_ARE_EQUAL(expected, actual);
+        VERIFY_ARE_EQUAL(buffer.SearchText(L"ab", SearchFlag::CaseInsensitive), actual);
+
+        actual = buffer.SearchText(L"AB", SearchFlag::None);
+        VERIFY_IS_TRUE(actual && actual->empty());
+    }
 };
@@ -26,6 +26,7 @@ namespace TerminalAppLocalTests
         TEST_METHOD(VerifyWeight);
         TEST_METHOD(VerifyCompare);
         TEST_METHOD(VerifyCompareIgnoreCase);
+        TEST_METHOD(VerifyNarrowingFilter);
     };
 
     void FilteredCommandTests::VerifyHighlighting()
@@ -229,4 +230,32 @@ namespace TerminalAppLocalTests
 
         VERIFY_SUCCEEDED(result);
     }
+
+    void FilteredCommandTests::VerifyNarrowingFilter()
+    {
+        auto result = RunOnUIThread([]() {
+            const auto paletteItem{ winrt::make<winrt::TerminalApp::implementation::CommandLinePaletteItem>(L"AAAAAABBBBBBCCC") };
+            const auto filteredCommand = winrt::make_self<winrt::TerminalApp::implementation::FilteredCommand>(paletteItem);
+
+            Log::Comment(L"Testing that a non-matching filter stays non-matching when it's extended");
+            filteredCommand->UpdateFilter(L"ad");
+            VERIFY_ARE_EQUAL(filteredCommand->Weight(), 0);
+            filteredCommand->UpdateFilter(L"adc");
+            VERIFY_ARE_EQUAL(filteredCommand->Filter(), L"adc");
+            VERIFY_ARE_EQUAL(filteredCommand->Weight(), 0);
+            auto segments = filteredCommand->HighlightedName().Segments();
+            VERIFY_ARE_EQUAL(segments.Size(), 1u);
+            VERIFY_ARE_EQUAL(segments.GetAt(0).TextSegment(), L"AAAAAABBBBBBCCC");
+            VERIFY_IS_FALSE(segments.GetAt(0).IsHighlighted());
+
+            Log::Comment(L"Testing that going back to a matching filter recomputes the weight");
+            filteredCommand->UpdateFilter(L"a");
+            VERIFY_ARE_NOT_EQUAL(filteredCommand->Weight(), 0);
+            segments = filteredCommand->HighlightedName().Segments();
+            VERIFY_ARE_EQUAL(segments.Size(), 2u);
+            VERIFY_IS_TRUE(segments.GetAt(0).IsHighlighted());
+        });
+
+        VERIFY_SUCCEEDED(result);
+    }
 }
@@ -4,6 +4,8 @@
 #include "pch.h"
 #include "DebugTapConnection.h"
 
+#include <til/unicode.h>
+
 using namespace ::winrt::Microsoft::Terminal::TerminalConnection;
 using namespace ::winrt::Windows::Foundation;
 namespace winrt::Microsoft::TerminalApp::implementation
@@ -44,7 +46,11 @@ namespace winrt::Microsoft::TerminalApp::implementation
             _pairedTap->_PrintInput(winrt_array_to_wstring_view(buffer));
             _wrappedConnection.WriteInput(buffer);
         }
-        void Resize(uint32_t rows, uint32_t columns) { _wrappedConnection.Resize(rows, columns); }
+        void Resize(uint32_t rows, uint32_t columns)
+        {
+            _pairedTap->_Record(L'r', fmt::format(FMT_COMPILE(L"{}x{}"), columns, rows));
+            _wrappedConnection.Resize(rows, columns);
+        }
         void Close() { _wrappedConnection.Close(); }
         winrt::event_token TerminalOutput(const TerminalOutputHandler& args) { return _wrappedConnection.TerminalOutput(args); };
         void TerminalOutput(const winrt::event_token& token) noexcept { _wrappedConnection.TerminalOutput(token); };
@@ -58,13 +64,20 @@ namespace winrt::Microsoft::TerminalApp::implementation
         ITerminalConnection _wrappedConnection;
     };
 
-    DebugTapConnection::DebugTapConnection(ITerminalConnection wrappedConnection)
+    // The recording stops once the file reaches this size, so that a long-running session can't fill up the disk.
+    static constexpr uint64_t maxRecordingSize = 64 * 1024 * 1024;
+
+    DebugTapConnection::DebugTapConnection(ITerminalConnection wrappedConnection, bool record)
     {
         _outputRevoker = wrappedConnection.TerminalOutput(winrt::auto_revoke, { this, &DebugTapConnection::_OutputHandler });
         _stateChangedRevoker = wrappedConnection.StateChanged(winrt::auto_revoke, [this](auto&& /*s*/, auto&& /*e*/) {
             StateChanged.raise(*this, nullptr);
         });
         _wrappedConnection = wrappedConnection;
+        if (record)
+        {
+            _StartRecording();
+        }
     }
 
     DebugTapConnection::~DebugTapConnection() = default;
@@ -73,6 +86,11 @@ namespace winrt::Microsoft::TerminalApp::implementation
     {
         // presume the wrapped connection is started.
 
+        if (!_recordingPath.empty())
+        {
+            TerminalOutput.raise(fmt::format(FMT_COMPILE(L"\x1b[90mRecording input and output to {}\x1b[m\r\n"), _recordingPath));
+        }
+
         // This is explained in the comment for GH#11282 above.
         _start.count_down();
     }
@@ -119,6 +137,8 @@ namespace winrt::Microsoft::TerminalApp::implementation
 
     void DebugTapConnection::_OutputHandler(const std::wstring_view str)
     {
+        _Record(L'o', str);
+
         auto output = til::visualize_control_codes(str);
         // To make the output easier to read, we introduce a line break whenever
         // an LF control is encountered. But at this point, the LF would have
@@ -133,11 +153,116 @@ namespace winrt::Microsoft::TerminalApp::implementation
     // Called by the DebugInputTapConnection to print user input
     void DebugTapConnection::_PrintInput(const std::wstring_view str)
     {
+        _Record(L'i', str);
+
         auto clean{ til::visualize_control_codes(str) };
         auto formatted{ wil::str_printf<std::wstring>(L"\x1b[91m%ls\x1b[m", clean.data()) };
         TerminalOutput.raise(formatted);
     }
 
+    // Creates the recording file in %TEMP%. Failing to do so only disables the recording.
+    void DebugTapConnection::_StartRecording() noexcept
+    try
+    {
+        wchar_t tempPath[MAX_PATH + 1];
+        const auto tempPathLength = GetTempPathW(ARRAYSIZE(tempPath), &tempPath[0]);
+        THROW_LAST_ERROR_IF(tempPathLength == 0 || tempPathLength > MAX_PATH);
+
+        auto path = fmt::format(FMT_COMPILE(L"{}WindowsTerminal-{}-{}.cast"), std::wstring_view{ &tempPath[0], tempPathLength }, GetCurrentProcessId(), GetTickCount64());
+        wil::unique_hfile file{ CreateFileW(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr) };
+        THROW_LAST_ERROR_IF(!file);
+
+        // The size will be corrected by the first "r" event, once the control got laid out.
+        static constexpr std::string_view header{ "{\"version\": 2, \"width\": 80, \"height\": 24}\n" };
+        THROW_IF_WIN32_BOOL_FALSE(WriteFile(file.get(), header.data(), gsl::narrow_cast<DWORD>(header.size()), nullptr, nullptr));
+
+        LARGE_INTEGER now, frequency;
+        QueryPerformanceCounter(&now);
+        QueryPerformanceFrequency(&frequency);
+
+        const auto lock = std::scoped_lock{ _recordingMutex };
+        _recordingSize = header.size();
+        _recording = std::move(file);
+        _recordingPath = std::move(path);
+        _recordingStart = now.QuadPart;
+        _recordingFrequency = frequency.QuadPart;
+    }
+    CATCH_LOG()
+
+    // Appends a single asciicast event of the given type ("o" output, "i" input, "r" resize).
+    void DebugTapConnection::_Record(const wchar_t type, std::wstring_view data) noexcept
+    try
+    {
+        const auto lock = std::scoped_lock{ _recordingMutex };
+        if (!_recording)
+        {
+            return;
+        }
+
+        LARGE_INTEGER now;
+        QueryPerformanceCounter(&now);
+        const auto seconds = static_cast<double>(now.QuadPart - _recordingStart) / static_cast<double>(_recordingFrequency);
+
+        std::wstring escaped;
+        escaped.reserve(data.size() + 16);
+
+        // A surrogate pair may be split across two chunks. Converting each half on its own would turn them into
+        // U+FFFD, so we carry a trailing high surrogate over to the next chunk of the same stream.
+        if (type == L'o' || type == L'i')
+        {
+            auto& lead = _recordingLeadSurrogate[type == L'i'];
+            if (lead)
+            {
+                escaped.push_back(lead);
+                lead = 0;
+            }
+            if (!data.empty() && til::is_leading_surrogate(data.back()))
+            {
+                lead = data.back();
+                data.remove_suffix(1);
+            }
+        }
+
+        for (const auto ch : data)
+        {
+            switch (ch)
+            {
+            case L'"':
+                escaped.append(L"\\\"");
+                break;
+            case L'\\':
+                escaped.append(L"\\\\");
+                break;
+            default:
+                if (ch < L' ' || ch == L'\x7f')
+                {
+                    fmt::format_to(std::back_inserter(escaped), FMT_COMPILE(L"\\u{:04x}"), static_cast<unsigned int>(ch));
+                }
+                else
+                {
+                    escaped.push_back(ch);
+                }
+                break;
+            }
+        }
+
+        const auto line = til::u16u8(fmt::format(FMT_COMPILE(L"[{:.6f}, \"{}\", \"{}\"]\n"), seconds, type, escaped));
+        _recordingSize += line.size();
+        if (_recordingSize > maxRecordingSize)
+        {
+            _recording.reset();
+            return;
+        }
+
+        if (!WriteFile(_recording.get(), line.data(), gsl::narrow_cast<DWORD>(line.size()), nullptr, nullptr))
+        {
+            // Don't keep trying (and failing) for every single chunk of output.
+            LOG_LAST_ERROR();
+            _recording.reset();
+        }
+    }
+    CATCH_LOG()
+
     // Wire us up so that we can forward input through
     void DebugTapConnection::SetInputTap(const Microsoft::Terminal::TerminalConnection::ITerminalConnection& inputTap)
     {
@@ -149,10 +274,11 @@ namespace winrt::Microsoft::TerminalApp::implementation
 // - Takes one connection and returns two connections:
 //   1. One that can be used in place of the original connection (wrapped)
 //   2. One that will print raw VT sequences sent into and received _from_ the original connection.
-std::tuple<ITerminalConnection, ITerminalConnection> OpenDebugTapConnection(ITerminalConnection baseConnection)
+// - If `record` is true, the traffic is additionally recorded into an asciicast file in %TEMP%.
+std::tuple<ITerminalConnection, ITerminalConnection> OpenDebugTapConnection(ITerminalConnection baseConnection, bool record)
 {
     using namespace winrt::Microsoft::TerminalApp::implementation;
-    auto debugSide{ winrt::make_self<DebugTapConnection>(baseConnection) };
+    auto debugSide{ winrt::make_self<DebugTapConnection>(baseConnection, record) };
     auto inputSide{ winrt::make_self<DebugInputTapConnection>(debugSide, baseConnection) };
     debugSide->SetInputTap(*inputSide);
     std::tuple<ITerminalConnection, ITerminalConnection> p{ *inputSide, *debugSide };
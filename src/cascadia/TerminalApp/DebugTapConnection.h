@@ -12,7 +12,7 @@ namespace winrt::Microsoft::TerminalApp::implementation
     class DebugTapConnection : public winrt::implements<DebugTapConnection, winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection>
     {
     public:
-        explicit DebugTapConnection(Microsoft::Terminal::TerminalConnection::ITerminalConnection wrappedConnection);
+        DebugTapConnection(Microsoft::Terminal::TerminalConnection::ITerminalConnection wrappedConnection, bool record);
         void Initialize(const Windows::Foundation::Collections::ValueSet& /*settings*/){};
         ~DebugTapConnection();
         void Start();
@@ -32,6 +32,8 @@ namespace winrt::Microsoft::TerminalApp::implementation
     private:
         void _PrintInput(const std::wstring_view data);
         void _OutputHandler(const std::wstring_view str);
+        void _StartRecording() noexcept;
+        void _Record(const wchar_t type, std::wstring_view data) noexcept;
 
         winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection::TerminalOutput_revoker _outputRevoker;
         winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection::StateChanged_revoker _stateChangedRevoker;
@@ -40,8 +42,19 @@ namespace winrt::Microsoft::TerminalApp::implementation
 
         til::latch _start{ 1 };
 
+        // If enabled via "experimental.recordDebugTap", the connection's traffic is recorded into an
+        // asciicast v2 file, so that it can be replayed later. Input and output arrive on different threads.
+        std::mutex _recordingMutex;
+        wil::unique_hfile _recording;
+        std::wstring _recordingPath;
+        int64_t _recordingStart = 0;
+        int64_t _recordingFrequency = 0;
+        uint64_t _recordingSize = 0;
+        // A high surrogate at the end of a chunk, held back until the rest of the pair arrives. [0] is output, [1] input.
+        wchar_t _recordingLeadSurrogate[2]{};
+
         friend class DebugInputTapConnection;
     };
 }
 
-std::tuple<winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection, winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection> OpenDebugTapConnection(winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection baseConnection);
+std::tuple<winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection, winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection> OpenDebugTapConnection(winrt::Microsoft::Terminal::TerminalConnection::ITerminalConnection baseConnection, bool record);
@@ -56,9 +56,16 @@ namespace winrt::TerminalApp::implementation
         // that might result in triggering a notification event
         if (filter != _Filter)
         {
+            // If the previous filter didn't match, then no filter starting with it will match either.
+            // This is the common case while typing, so we can skip the highlighting for most commands.
+            const auto narrowed = _Weight == 0 && !_Filter.empty() && til::starts_with(filter, _Filter);
+
             Filter(filter);
-            HighlightedName(_computeHighlightedName());
-            Weight(_computeWeight());
+            if (!narrowed)
+            {
+                HighlightedName(_computeHighlightedName());
+                Weight(_computeWeight());
+            }
         }
     }
 
@@ -366,6 +366,9 @@ namespace winrt::TerminalApp::implementation
                 if (!path.empty())
                 {
                     const auto buffer = control.ReadEntireBuffer();
+
+                    // Converting and writing out a large buffer can take a moment. Don't block the UI thread with it.
+                    co_await winrt::resume_background();
                     til::io::write_utf8_string_to_file_atomic(std::filesystem::path{ std::wstring_view{ path } }, til::u16u8(buffer));
                 }
             }
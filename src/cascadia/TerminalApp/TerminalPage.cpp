@@ -3333,7 +3333,7 @@ namespace winrt::TerminalApp::implementation
                                          WI_IsFlagSet(rAltState, CoreVirtualKeyStates::Down);
             if (bothAltsPressed)
             {
-                std::tie(connection, debugConnection) = OpenDebugTapConnection(connection);
+                std::tie(connection, debugConnection) = OpenDebugTapConnection(connection, _settings.GlobalSettings().DebugTapRecording());
             }
         }
 
@@ -954,10 +954,22 @@ namespace winrt::TerminalApp::implementation
                 // copy `weakThis` onto the stack, because that's the only thing that gets captured in coroutines.
                 // See: https://devblogs.microsoft.com/oldnewthing/20211103-00/?p=105870
                 const auto weakThisCopy = weakThis;
+
+                // Shells and progress tools can change the title on every line of output. UpdateTitle()
+                // reads the latest title anyway, so we only need a single call queued at any time.
+                if (const auto tab{ weakThisCopy.get() })
+                {
+                    if (tab->_titleUpdatePending.exchange(true, std::memory_order_relaxed))
+                    {
+                        co_return;
+                    }
+                }
+
                 co_await wil::resume_foreground(dispatcher);
                 // Check if Tab's lifetime has expired
                 if (auto tab{ weakThisCopy.get() })
                 {
+                    tab->_titleUpdatePending.store(false, std::memory_order_relaxed);
                     // The title of the control changed, but not necessarily the title of the tab.
                     // Set the tab's text to the active panes' text.
                     tab->UpdateTitle();
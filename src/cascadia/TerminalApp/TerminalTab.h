@@ -152,6 +152,8 @@ namespace winrt::TerminalApp::implementation
         bool _receivedKeyDown{ false };
         bool _iconHidden{ false };
         bool _changingActivePane{ false };
+        // Set while an UpdateTitle() call is queued on the UI thread. See _AttachEventHandlersToContent().
+        std::atomic<bool> _titleUpdatePending{ false };
 
         winrt::hstring _runtimeTabText{};
         bool _inRename{ false };
@@ -201,8 +201,11 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 
         if (_state == AzureState::TermConnected)
         {
-            auto buff{ winrt::to_string(data) };
-            WinHttpWebSocketSend(_webSocket.get(), WINHTTP_WEB_SOCKET_UTF8_MESSAGE_BUFFER_TYPE, buff.data(), gsl::narrow<DWORD>(buff.size()));
+            if (FAILED_LOG(til::u16u8(data, _writeBuffer)))
+            {
+                return;
+            }
+            WinHttpWebSocketSend(_webSocket.get(), WINHTTP_WEB_SOCKET_UTF8_MESSAGE_BUFFER_TYPE, _writeBuffer.data(), gsl::narrow<DWORD>(_writeBuffer.size()));
             return;
         }
 
@@ -100,7 +100,8 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 
         til::u8state _u8State{};
         std::wstring _u16Str;
-        std::array<char, 4096> _buffer{};
+        std::array<char, 128 * 1024> _buffer{};
+        std::string _writeBuffer;
 
         static winrt::hstring _ParsePreferredShellType(const winrt::Windows::Data::Json::JsonObject& settingsResponse);
     };
@@ -28,6 +28,21 @@ using namespace ::Microsoft::Console;
 
 namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
 {
+    // Spawning OpenConsole makes up most of the time it takes to open a new tab. Once a connection has
+    // started, we keep one unused pseudoconsole with the same flags around, so that the next one can skip that.
+    // Its size doesn't matter, because it gets resized before the client is launched. It's intentionally
+    // leaked on exit. OpenConsole exits on its own once our end of the pipe is closed.
+    struct SparePseudoConsole
+    {
+        DWORD flags = 0;
+        HANDLE pipe = nullptr;
+        HPCON hPC = nullptr;
+    };
+
+    static std::mutex s_spareMutex;
+    static SparePseudoConsole s_spare;
+    static bool s_sparePending = false;
+
     // Function Description:
     // - launches the client application attached to the new pseudoconsole
     HRESULT ConptyConnection::_LaunchAttachedClient() noexcept
@@ -344,9 +359,12 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         // handoff from an already-started PTY process.
         if (!_pipe)
         {
-            auto pipe = Utils::CreateOverlappedPipe(PIPE_ACCESS_DUPLEX, 128 * 1024);
-            THROW_IF_FAILED(ConptyCreatePseudoConsole(til::unwrap_coord_size(dimensions), pipe.client.get(), pipe.client.get(), _flags, &_hPC));
-            _pipe = std::move(pipe.server);
+            if (!_claimSparePseudoConsole(dimensions))
+            {
+                auto pipe = Utils::CreateOverlappedPipe(PIPE_ACCESS_DUPLEX, 128 * 1024);
+                THROW_IF_FAILED(ConptyCreatePseudoConsole(til::unwrap_coord_size(dimensions), pipe.client.get(), pipe.client.get(), _flags, &_hPC));
+                _pipe = std::move(pipe.server);
+            }
 
             if (_initialParentHwnd != 0)
             {
@@ -360,6 +378,7 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
             }
 
             THROW_IF_FAILED(_LaunchAttachedClient());
+            _prepareSparePseudoConsole(_flags);
         }
         // But if it was an inbound handoff... attempt to synchronize the size of it with what our connection
         // window is expecting it to be on the first layout.
@@ -768,6 +787,95 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         ::ConptyClosePseudoConsole(hPC);
     }
 
+    // Takes over the spare pseudoconsole prepared by _prepareSparePseudoConsole(), if its flags match ours.
+    // Returns false if there's none, in which case the caller needs to create one.
+    bool ConptyConnection::_claimSparePseudoConsole(const til::size dimensions) noexcept
+    {
+        SparePseudoConsole spare;
+        {
+            const std::lock_guard lock{ s_spareMutex };
+            if (!s_spare.hPC || s_spare.flags != _flags)
+            {
+                return false;
+            }
+            spare = std::exchange(s_spare, {});
+        }
+
+        _pipe.reset(spare.pipe);
+        _hPC.reset(spare.hPC);
+
+        // This fails if the spare OpenConsole has exited in the meantime.
+        if (FAILED(ConptyResizePseudoConsole(_hPC.get(), til::unwrap_coord_size(dimensions))))
+        {
+            _hPC.reset();
+            _pipe.reset();
+            return false;
+        }
+
+        return true;
+    }
+
+    // Spawns a spare pseudoconsole with the given flags in the background, unless there already is one.
+    void ConptyConnection::_prepareSparePseudoConsole(const DWORD flags) noexcept
+    {
+        // With PSEUDOCONSOLE_INHERIT_CURSOR, OpenConsole asks the terminal for the cursor position
+        // on startup. That only works for the connection that's reading from it at that time.
+        if (WI_IsFlagSet(flags, PSEUDOCONSOLE_INHERIT_CURSOR))
+        {
+            return;
+        }
+
+        {
+            const std::lock_guard lock{ s_spareMutex };
+            if (s_sparePending || (s_spare.hPC && s_spare.flags == flags))
+            {
+                return;
+            }
+            s_sparePending = true;
+        }
+
+        const auto submitted = TrySubmitThreadpoolCallback(
+            [](PTP_CALLBACK_INSTANCE, PVOID context) noexcept {
+                SparePseudoConsole spare{ .flags = static_cast<DWORD>(reinterpret_cast<uintptr_t>(context)) };
+
+                try
+                {
+                    auto pipe = Utils::CreateOverlappedPipe(PIPE_ACCESS_DUPLEX, 128 * 1024);
+                    if (SUCCEEDED_LOG(ConptyCreatePseudoConsole({ 80, 24 }, pipe.client.get(), pipe.client.get(), spare.flags, &spare.hPC)))
+                    {
+                        spare.pipe = pipe.server.release();
+                    }
+                }
+                CATCH_LOG();
+
+                // Replace any spare with different flags.
+                SparePseudoConsole old;
+                {
+                    const std::lock_guard lock{ s_spareMutex };
+                    s_sparePending = false;
+                    if (spare.hPC)
+                    {
+                        old = std::exchange(s_spare, spare);
+                    }
+                }
+
+                if (old.hPC)
+                {
+                    closePseudoConsoleAsync(old.hPC);
+                    CloseHandle(old.pipe);
+                }
+            },
+            reinterpret_cast<PVOID>(static_cast<uintptr_t>(flags)),
+            nullptr);
+
+        if (!submitted)
+        {
+            LOG_LAST_ERROR();
+            const std::lock_guard lock{ s_spareMutex };
+            s_sparePending = false;
+        }
+    }
+
     HRESULT ConptyConnection::NewHandoff(HANDLE* in, HANDLE* out, HANDLE signal, HANDLE reference, HANDLE server, HANDLE client, const TERMINAL_STARTUP_INFO* startupInfo) noexcept
     try
     {
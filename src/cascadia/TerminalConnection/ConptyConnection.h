@@ -60,6 +60,8 @@ namespace winrt::Microsoft::Terminal::TerminalConnection::implementation
         static winrt::hstring _commandlineFromProcess(HANDLE process);
 
         HRESULT _LaunchAttachedClient() noexcept;
+        bool _claimSparePseudoConsole(const til::size dimensions) noexcept;
+        static void _prepareSparePseudoConsole(const DWORD flags) noexcept;
         void _indicateExitWithStatus(unsigned int status) noexcept;
         static std::wstring _formatStatus(uint32_t status);
         void _LastConPtyClientDisconnected() noexcept;
@@ -212,6 +212,17 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                 }
             });
 
+        // A window that stays minimized for a while doesn't need to hold on to its swap chain,
+        // glyph atlas and D3D device. They're recreated on the first frame after it's shown again.
+        shared->releaseRenderResources = std::make_unique<til::debounced_func_trailing<>>(
+            std::chrono::seconds{ 30 },
+            [weakThis = get_weak()]() {
+                if (const auto core{ weakThis.get() }; core && !core->_IsClosing())
+                {
+                    core->_releaseRenderResources();
+                }
+            });
+
         // Scrollbar updates are also expensive (XAML), so we'll throttle them as well.
         shared->updateScrollBar = std::make_shared<ThrottledFuncTrailing<Control::ScrollPositionChangedArgs>>(
             _dispatcher,
@@ -222,6 +233,44 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                     core->ScrollPositionChanged.raise(*core, update);
                 }
             });
+
+        // Progress bars may send OSC 9;4 for every single percent. The handlers only
+        // ever read the latest progress state, so one update per frame is plenty.
+        shared->updateTaskbarProgress = std::make_shared<ThrottledFuncTrailing<>>(
+            _dispatcher,
+            std::chrono::milliseconds{ 8 },
+            [weakThis = get_weak()]() {
+                if (auto core{ weakThis.get() }; core && !core->_IsClosing())
+                {
+                    core->TaskbarProgressChanged.raise(*core, nullptr);
+                }
+            });
+
+        // Dragging the window edge produces a SizeChanged for nearly every frame and each of them
+        // reflows the entire buffer. The swap chain follows the new size right away (clipping
+        // or padding the contents), while the buffer is only resized to the latest size.
+        shared->refreshSize = std::make_shared<ThrottledFuncTrailing<>>(
+            _dispatcher,
+            std::chrono::milliseconds{ 50 },
+            [weakThis = get_weak()]() {
+                if (auto core{ weakThis.get() }; core && !core->_IsClosing())
+                {
+                    const auto lock = core->_terminal->LockForWriting();
+                    core->_refreshSizeUnderLock();
+                }
+            });
+
+        // High polling rate mice report pointer moves up to 1000 times a second.
+        // In any-event mouse mode that's one sequence per move, which remote applications can't keep up with.
+        shared->flushMouseMotion = std::make_shared<ThrottledFuncTrailing<>>(
+            _dispatcher,
+            std::chrono::milliseconds{ 8 },
+            [weakThis = get_weak()]() {
+                if (auto core{ weakThis.get() }; core && !core->_IsClosing())
+                {
+                    core->_flushMouseMotion();
+                }
+            });
     }
 
     ControlCore::~ControlCore()
@@ -244,6 +293,11 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         const auto shared = _shared.lock();
         shared->outputIdle.reset();
         shared->updateScrollBar.reset();
+        shared->updateTaskbarProgress.reset();
+        shared->releaseRenderResources.reset();
+        shared->refreshSize.reset();
+        shared->flushMouseMotion.reset();
+        _pendingMouseMotion.reset();
     }
 
     void ControlCore::AttachToNewControl(const Microsoft::Terminal::Control::IKeyBindings& keyBindings)
@@ -663,11 +717,55 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         return false;
     }
 
+    // Sends a mouse event to the connection. Pointer moves are coalesced: If one arrives within
+    // 8ms of the previous one, only the latest position is sent once that time has passed.
+    // Any other event first sends the pending move, so that the order of events is preserved.
     bool ControlCore::SendMouseEvent(const til::point viewportPos,
                                      const unsigned int uiButton,
                                      const ControlKeyStates states,
                                      const short wheelDelta,
                                      const TerminalInput::MouseButtonState state)
+    {
+        if (uiButton != WM_MOUSEMOVE)
+        {
+            _flushMouseMotion();
+        }
+        else if (!_inUnitTests)
+        {
+            const auto shared = _shared.lock_shared();
+            if (shared->flushMouseMotion)
+            {
+                const auto now = std::chrono::steady_clock::now();
+                if (_pendingMouseMotion || now - _lastMouseMotion < std::chrono::milliseconds{ 8 })
+                {
+                    if (!_pendingMouseMotion)
+                    {
+                        shared->flushMouseMotion->Run();
+                    }
+                    _pendingMouseMotion = PendingMouseMotion{ viewportPos, states, state };
+                    return true;
+                }
+                _lastMouseMotion = now;
+            }
+        }
+
+        return _sendMouseEvent(viewportPos, uiButton, states, wheelDelta, state);
+    }
+
+    void ControlCore::_flushMouseMotion()
+    {
+        if (const auto motion = std::exchange(_pendingMouseMotion, std::nullopt))
+        {
+            _lastMouseMotion = std::chrono::steady_clock::now();
+            _sendMouseEvent(motion->viewportPos, WM_MOUSEMOVE, motion->states, 0, motion->state);
+        }
+    }
+
+    bool ControlCore::_sendMouseEvent(const til::point viewportPos,
+                                      const unsigned int uiButton,
+                                      const ControlKeyStates states,
+                                      const short wheelDelta,
+                                      const TerminalInput::MouseButtonState state)
     {
         TerminalInput::OutputType out;
         {
@@ -1094,22 +1192,16 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             return;
         }
 
-        auto cx = gsl::narrow_cast<til::CoordType>(lrint(_panelWidth * _compositionScale));
-        auto cy = gsl::narrow_cast<til::CoordType>(lrint(_panelHeight * _compositionScale));
-
-        // Don't actually resize so small that a single character wouldn't fit
-        // in either dimension. The buffer really doesn't like being size 0.
-        cx = std::max(cx, _actualFont.GetSize().width);
-        cy = std::max(cy, _actualFont.GetSize().height);
+        const auto sizeInPixels = _windowSizeInPixels();
 
         // Convert our new dimensions to characters
-        const auto viewInPixels = Viewport::FromDimensions({ 0, 0 }, { cx, cy });
+        const auto viewInPixels = Viewport::FromDimensions({ 0, 0 }, sizeInPixels);
         const auto vp = _renderEngine->GetViewportInCharacters(viewInPixels);
 
         _terminal->ClearSelection();
 
         // Tell the dx engine that our window is now the new size.
-        THROW_IF_FAILED(_renderEngine->SetWindowSize({ cx, cy }));
+        THROW_IF_FAILED(_renderEngine->SetWindowSize(sizeInPixels));
 
         // Invalidate everything
         _renderer->TriggerRedrawAll();
@@ -1134,6 +1226,20 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         }
     }
 
+    // Returns the size of the panel in pixels, but never less than a single character in either dimension.
+    til::size ControlCore::_windowSizeInPixels() const noexcept
+    {
+        auto cx = gsl::narrow_cast<til::CoordType>(lrint(_panelWidth * _compositionScale));
+        auto cy = gsl::narrow_cast<til::CoordType>(lrint(_panelHeight * _compositionScale));
+
+        // Don't actually resize so small that a single character wouldn't fit
+        // in either dimension. The buffer really doesn't like being size 0.
+        cx = std::max(cx, _actualFont.GetSize().width);
+        cy = std::max(cy, _actualFont.GetSize().height);
+
+        return { cx, cy };
+    }
+
     void ControlCore::SizeChanged(const float width,
                                   const float height)
     {
@@ -1171,6 +1277,21 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             // _updateFont relies on the new _compositionScale set above
             _updateFont();
         }
+
+        // A DPI change is usually followed by a burst of size changes while the window
+        // settles on the new monitor. Defer the buffer resize (and reflow) for those as
+        // well, so that it happens once at the final size instead of every step.
+        if (!_inUnitTests)
+        {
+            const auto shared = _shared.lock_shared();
+            if (shared->refreshSize)
+            {
+                LOG_IF_FAILED(_renderEngine->SetWindowSize(_windowSizeInPixels()));
+                _renderer->TriggerRedrawAll();
+                shared->refreshSize->Run();
+                return;
+            }
+        }
         _refreshSizeUnderLock();
     }
 
@@ -1559,6 +1680,18 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         // Since this can only ever be triggered by output from the connection,
         // then the Terminal already has the write lock when calling this
         // callback.
+        //
+        // Output like `cat`-ing a binary file can contain thousands of BELs. The TermControl
+        // only plays one bell per second anyway, so there's no point in raising an event for
+        // each of them. We keep this interval shorter than the TermControl's, so that the
+        // bell that ends its throttling interval still reaches it.
+        const auto now = std::chrono::steady_clock::now();
+        if (now - _lastWarningBell < std::chrono::milliseconds{ 100 })
+        {
+            return;
+        }
+        _lastWarningBell = now;
+
         WarningBell.raise(*this, nullptr);
     }
 
@@ -1619,7 +1752,18 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
     void ControlCore::_terminalTaskbarProgressChanged()
     {
-        TaskbarProgressChanged.raise(*this, nullptr);
+        if (_inUnitTests) [[unlikely]]
+        {
+            TaskbarProgressChanged.raise(*this, nullptr);
+        }
+        else
+        {
+            const auto shared = _shared.lock_shared();
+            if (shared->updateTaskbarProgress)
+            {
+                shared->updateTaskbarProgress->Run();
+            }
+        }
     }
 
     void ControlCore::_terminalShowWindowChanged(bool showOrHide)
@@ -1726,7 +1870,8 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
             if (searchInvalidated)
             {
-                oldResults = _searcher.ExtractResults();
+                // Search::Reset() may update the existing results incrementally, so we must not extract them.
+                oldResults = _searcher.Results();
                 _searcher.Reset(*_terminal.get(), request.Text, flags, !request.GoForward);
                 _terminal->SetSearchHighlights(_searcher.Results());
             }
@@ -2166,9 +2311,24 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     {
         try
         {
+            // Parsing an entire read from the connection (up to 128KiB) can take several milliseconds.
+            // Releasing the lock between slices allows key presses on the UI thread to get in between
+            // (the lock is fair), instead of making typing latency depend on the output volume.
+            static constexpr size_t sliceSize = 16 * 1024;
+            const std::wstring_view str{ hstr };
+
+            for (size_t beg = 0; beg < str.size();)
             {
+                auto end = std::min(beg + sliceSize, str.size());
+                // Don't split up surrogate pairs.
+                if (end < str.size() && til::is_leading_surrogate(til::at(str, end - 1)))
+                {
+                    ++end;
+                }
+
                 const auto lock = _terminal->LockForWriting();
-                _terminal->Write(hstr);
+                _terminal->Write(str.substr(beg, end - beg));
+                beg = end;
             }
 
             if (!_pendingResponses.empty())
@@ -2252,12 +2412,14 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
     hstring ControlCore::ReadEntireBuffer() const
     {
-        const auto lock = _terminal->LockForWriting();
+        // LockForReading() takes the same exclusive lock as LockForWriting(). It blocks
+        // the output thread just the same, so this should do as little work as possible.
+        const auto lock = _terminal->LockForReading();
 
         const auto& textBuffer = _terminal->GetTextBuffer();
+        const auto lastRow = textBuffer.GetLastNonSpaceCharacter().y;
 
         std::wstring str;
-        const auto lastRow = textBuffer.GetLastNonSpaceCharacter().y;
         for (auto rowIndex = 0; rowIndex <= lastRow; rowIndex++)
         {
             const auto& row = textBuffer.GetRowByOffset(rowIndex);
@@ -2471,6 +2633,30 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     {
         if (_initializedTerminal.load(std::memory_order_relaxed))
         {
+            // Nobody can see a minimized window, so there's no point in rendering any frames
+            // for it, even if the application keeps printing output. Once we're shown again
+            // we simply redraw everything instead of tracking what changed in the meantime.
+            if (_paintingSuspended == showOrHide)
+            {
+                const auto lock = _terminal->LockForWriting();
+                if (showOrHide)
+                {
+                    _renderer->EnablePainting();
+                    _renderer->TriggerRedrawAll();
+                }
+                else
+                {
+                    _renderer->DisablePainting();
+
+                    const auto shared = _shared.lock_shared();
+                    if (shared->releaseRenderResources)
+                    {
+                        shared->releaseRenderResources->Run();
+                    }
+                }
+                _paintingSuspended = !showOrHide;
+            }
+
             // show is true, hide is false
             if (auto conpty{ _connection.try_as<TerminalConnection::ConptyConnection>() })
             {
@@ -2479,6 +2665,24 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         }
     }
 
+    void ControlCore::_releaseRenderResources()
+    {
+        // Painting has already been disabled by WindowVisibilityChanged(),
+        // but a frame might still be in flight. This can't be done under the lock.
+        _renderer->WaitForPaintCompletionAndDisable(INFINITE);
+
+        const auto lock = _terminal->LockForWriting();
+        if (_paintingSuspended)
+        {
+            _renderEngine->ReleaseResources();
+        }
+        else
+        {
+            // We got shown again in the meantime. Undo our WaitForPaintCompletionAndDisable().
+            _renderer->EnablePainting();
+        }
+    }
+
     // Method Description:
     // - When the control gains focus, it needs to tell ConPTY about this.
     //   Usually, these sequences are reserved for applications that
@@ -2510,6 +2714,13 @@ namespace winrt::Microsoft::Terminal::Control::implementation
 
     void ControlCore::_focusChanged(bool focused)
     {
+        // Unfocused panes (like a background tab running a build) shouldn't compete
+        // for the CPU with the pane the user is typing in.
+        if (_renderer)
+        {
+            _renderer->SetLowPriority(!focused);
+        }
+
         TerminalInput::OutputType out;
         {
             const auto lock = _terminal->LockForReading();
@@ -307,6 +307,17 @@ namespace winrt::Microsoft::Terminal::Control::implementation
             std::unique_ptr<til::debounced_func_trailing<>> outputIdle;
             std::unique_ptr<til::debounced_func_trailing<bool>> focusChanged;
             std::shared_ptr<ThrottledFuncTrailing<Control::ScrollPositionChangedArgs>> updateScrollBar;
+            std::shared_ptr<ThrottledFuncTrailing<>> updateTaskbarProgress;
+            std::unique_ptr<til::debounced_func_trailing<>> releaseRenderResources;
+            std::shared_ptr<ThrottledFuncTrailing<>> refreshSize;
+            std::shared_ptr<ThrottledFuncTrailing<>> flushMouseMotion;
+        };
+
+        struct PendingMouseMotion
+        {
+            til::point viewportPos;
+            ::Microsoft::Terminal::Core::ControlKeyStates states;
+            ::Microsoft::Console::VirtualTerminal::TerminalInput::MouseButtonState state;
         };
 
         std::atomic<bool> _initializedTerminal{ false };
@@ -349,9 +360,17 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         uint16_t _lastHoveredId{ 0 };
 
         bool _isReadOnly{ false };
+        // Set while the window is minimized and painting was disabled. See WindowVisibilityChanged().
+        bool _paintingSuspended{ false };
 
         std::optional<interval_tree::IntervalTree<til::point, size_t>::interval> _lastHoveredInterval{ std::nullopt };
 
+        // Pointer moves that arrived too soon after the last one. See SendMouseEvent().
+        std::optional<PendingMouseMotion> _pendingMouseMotion;
+        std::chrono::steady_clock::time_point _lastMouseMotion{};
+        // BELs that arrived too soon after the last one are dropped. See _terminalWarningBell().
+        std::chrono::steady_clock::time_point _lastWarningBell{};
+
         // These members represent the size of the surface that we should be
         // rendering to.
         float _panelWidth{ 0 };
@@ -372,10 +391,17 @@ namespace winrt::Microsoft::Terminal::Control::implementation
         bool _setFontSizeUnderLock(float fontSize);
         void _updateFont();
         void _refreshSizeUnderLock();
+        til::size _windowSizeInPixels() const noexcept;
         void _updateSelectionUI();
         bool _shouldTryUpdateSelection(const WORD vkey);
 
         void _handleControlC();
+        bool _sendMouseEvent(const til::point viewportPos,
+                             const unsigned int uiButton,
+                             const ::Microsoft::Terminal::Core::ControlKeyStates states,
+                             const short wheelDelta,
+                             const ::Microsoft::Console::VirtualTerminal::TerminalInput::MouseButtonState state);
+        void _flushMouseMotion();
         void _sendInputToConnection(std::wstring_view wstr);
 
 #pragma region TerminalCoreCallbacks
@@ -386,6 +412,7 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                                             const int viewHeight,
                                             const int bufferSize);
         void _terminalTaskbarProgressChanged();
+        void _releaseRenderResources();
         void _terminalShowWindowChanged(bool showOrHide);
         void _terminalPlayMidiNote(const int noteNumber,
                                    const int velocity,
@@ -586,14 +586,20 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                 const auto color = core->ForegroundColor();
                 const auto rightAlignedOffset = (scrollBarWidthInPx - pipWidth) * sizeof(til::color);
                 til::CoordType lastRow = til::CoordTypeMin;
+                uint8_t* lastBase = nullptr;
 
                 for (const auto& span : searchMatches)
                 {
                     if (lastRow != span.start.y)
                     {
                         lastRow = span.start.y;
+                        // With thousands of hits in a long buffer, most of them map to a bitmap row we've already drawn.
                         const auto base = dataAt(lastRow) + rightAlignedOffset;
-                        drawPip(base, color);
+                        if (base != lastBase)
+                        {
+                            lastBase = base;
+                            drawPip(base, color);
+                        }
                     }
                 }
             }
@@ -1432,6 +1438,9 @@ namespace winrt::Microsoft::Terminal::Control::implementation
     {
         const auto path = std::exchange(_restorePath, {});
         const auto weakSelf = get_weak();
+        // Controls that aren't focused (for instance the other panes of a restored tab) replay their
+        // buffer on a below-normal priority thread, so that they don't compete with the focused one.
+        const auto lowPriority = !_focused;
         winrt::apartment_context uiThread;
 
         try
@@ -1444,6 +1453,19 @@ namespace winrt::Microsoft::Terminal::Control::implementation
                 co_return;
             }
 
+            const auto thread = GetCurrentThread();
+            const auto previousPriority = GetThreadPriority(thread);
+            if (lowPriority && previousPriority != THREAD_PRIORITY_ERROR_RETURN)
+            {
+                SetThreadPriority(thread, THREAD_PRIORITY_BELOW_NORMAL);
+            }
+            const auto restorePriority = wil::scope_exit([&]() {
+                if (lowPriority && previousPriority != THREAD_PRIORITY_ERROR_RETURN)
+                {
+                    SetThreadPriority(thread, previousPriority);
+                }
+            });
+
             winrt::get_self<ControlCore>(_core)->RestoreFromPath(path.c_str());
         }
         CATCH_LOG();
@@ -11,7 +11,6 @@
 #include "../../buffer/out/search.h"
 #include "../../buffer/out/UTextAdapter.h"
 
-#include <til/hash.h>
 #include <winrt/Microsoft.Terminal.Core.h>
 
 using namespace winrt::Microsoft::Terminal::Core;
@@ -1189,7 +1188,7 @@ void Terminal::SetCursorOn(const bool isOn) noexcept
 void Terminal::UpdatePatternsUnderLock()
 {
     _InvalidatePatternTree();
-    _patternIntervalTree = _getPatterns(_VisibleStartIndex(), _VisibleEndIndex());
+    _patternIntervalTree = PointTree{ _getPatternsCached(_VisibleStartIndex(), _VisibleEndIndex()) };
     _InvalidatePatternTree();
 }
 
@@ -1370,91 +1369,102 @@ void Terminal::_updateUrlDetection()
     }
 }
 
-struct URegularExpressionInterner
+PointTree Terminal::_getPatterns(til::CoordType beg, til::CoordType end) const
 {
-    // Interns (caches) URegularExpression instances so that they can be reused. This method is thread-safe.
-    // uregex_open is not terribly expensive at ~10us/op, but it's also much more expensive than uregex_clone
-    // at ~400ns/op and would effectively double the time it takes to scan the viewport for patterns.
-    //
-    // An alternative approach would be to not make this method thread-safe and give each
-    // Terminal instance its own cache. I'm not sure which approach would have been better.
-    ICU::unique_uregex Intern(const std::wstring_view& pattern)
+    if (!_detectURLs)
     {
-        UErrorCode status = U_ZERO_ERROR;
-
-        {
-            const auto guard = _lock.lock_shared();
-            if (const auto it = _cache.find(pattern); it != _cache.end())
-            {
-                return ICU::unique_uregex{ uregex_clone(it->second.re.get(), &status) };
-            }
-        }
+        return {};
+    }
 
-        // Even if the URegularExpression creation failed, we'll insert it into the cache, because there's no point in retrying.
-        // (Apart from OOM but in that case this application will crash anyways in 3.. 2.. 1..)
-        auto re = ICU::CreateRegex(pattern, 0, &status);
-        ICU::unique_uregex clone{ uregex_clone(re.get(), &status) };
-        std::wstring key{ pattern };
+    PointTree::interval_vector intervals;
+    _findPatterns(intervals, beg, end, beg);
+    return PointTree{ std::move(intervals) };
+}
 
-        const auto guard = _lock.lock_exclusive();
+// Same as _getPatterns(), but only scans the rows that changed since the last call.
+// Every ROW remembers the mutation id at which it was last modified, so any row whose text could
+// affect a match and whose revision is older than the last scan will produce the same matches.
+PointTree::interval_vector Terminal::_getPatternsCached(til::CoordType beg, til::CoordType end)
+{
+    if (!_detectURLs)
+    {
+        _patternCache = {};
+        return {};
+    }
 
-        _cache.insert_or_assign(std::move(key), CacheValue{ std::move(re), _totalInsertions });
-        _totalInsertions++;
+    const auto& buffer = _activeBuffer();
+    auto& cache = _patternCache;
+    // All rows in [beg,dirty) are known to be unchanged since the last scan.
+    auto dirty = beg;
 
-        // If the cache is full remove the oldest element (oldest = lowest generation, just like with humans).
-        if (_cache.size() > cacheSizeLimit)
+    if (cache.buffer == &buffer)
+    {
+        if (const auto rows = buffer.GetDirtyRows(cache.revision))
         {
-            _cache.erase(std::min_element(_cache.begin(), _cache.end(), [](const auto& it, const auto& smallest) {
-                return it.second.generation < smallest.second.generation;
-            }));
-        }
-
-        return clone;
-    }
+            // IncrementCircularBuffer() moved the previously scanned rows up by `scrolled` rows.
+            const auto cacheBeg = cache.beg - rows->scrolled;
+            const auto cacheEnd = cache.end - rows->scrolled;
 
-private:
-    struct CacheValue
-    {
-        ICU::unique_uregex re;
-        size_t generation = 0;
-    };
+            // We can't reuse anything if the viewport starts above the previously scanned rows, or if it
+            // starts in the middle of a wrapped line, since the previous matches may extend above `beg`.
+            if (cacheBeg <= beg && beg <= cacheEnd && (beg == cacheBeg || !buffer.GetRowByOffset(beg - 1).WasWrapForced()))
+            {
+                const auto limit = std::min(cacheEnd + 1, end + 1);
+                dirty = std::max(beg, rows->begin);
+                for (; dirty < limit && buffer.GetRowByOffset(dirty).GetRevision() <= cache.revision.mutationId; ++dirty)
+                {
+                }
 
-    struct CacheKeyHasher
-    {
-        using is_transparent = void;
+                // Matches may span wrapped lines, so we need to rescan the entire line starting at `dirty`.
+                for (; dirty > beg && buffer.GetRowByOffset(dirty - 1).WasWrapForced(); --dirty)
+                {
+                }
 
-        std::size_t operator()(const std::wstring_view& str) const noexcept
-        {
-            return til::hash(str);
+                // Keep the matches that lie within [beg,dirty) and make them relative to `beg`.
+                const auto keepBeg = beg - cacheBeg;
+                const auto keepEnd = dirty - cacheBeg;
+                std::erase_if(cache.intervals, [&](const PointTree::interval& interval) {
+                    return interval.start.y < keepBeg || interval.start.y >= keepEnd;
+                });
+                for (auto& interval : cache.intervals)
+                {
+                    interval.start.y -= keepBeg;
+                    interval.stop.y -= keepBeg;
+                }
+            }
         }
-    };
+    }
 
-    static constexpr size_t cacheSizeLimit = 128;
-    wil::srwlock _lock;
-    std::unordered_map<std::wstring, CacheValue, CacheKeyHasher, std::equal_to<>> _cache;
-    size_t _totalInsertions = 0;
-};
+    if (dirty == beg)
+    {
+        cache.intervals.clear();
+    }
+    if (dirty <= end)
+    {
+        _findPatterns(cache.intervals, dirty, end, beg);
+    }
 
-static URegularExpressionInterner uregexInterner;
+    cache.buffer = &buffer;
+    cache.revision = buffer.GetRevisionCursor();
+    cache.beg = beg;
+    cache.end = end;
+    return cache.intervals;
+}
 
-PointTree Terminal::_getPatterns(til::CoordType beg, til::CoordType end) const
+// Appends all pattern matches in the rows [beg,end] to `intervals`. The y-coordinates of the
+// matches are relative to the `origin` row, since PointTree stores viewport-relative coordinates.
+void Terminal::_findPatterns(PointTree::interval_vector& intervals, til::CoordType beg, til::CoordType end, til::CoordType origin) const
 {
     static constexpr std::array<std::wstring_view, 1> patterns{
         LR"(\b(?:https?|ftp|file)://[-A-Za-z0-9+&@#/%?=~_|$!:,.;]*[A-Za-z0-9+&@#/%=~_|$])",
     };
 
-    if (!_detectURLs)
-    {
-        return {};
-    }
-
     auto text = ICU::UTextFromTextBuffer(_activeBuffer(), beg, end + 1);
     UErrorCode status = U_ZERO_ERROR;
-    PointTree::interval_vector intervals;
 
     for (size_t i = 0; i < patterns.size(); ++i)
     {
-        const auto re = uregexInterner.Intern(patterns.at(i));
+        const auto re = ICU::InternRegex(patterns.at(i), 0, &status);
         uregex_setUText(re.get(), &text, &status);
 
         if (uregex_find(re.get(), -1, &status))
@@ -1463,15 +1473,13 @@ PointTree Terminal::_getPatterns(til::CoordType beg, til::CoordType end) const
             {
                 auto range = ICU::BufferRangeFromMatch(&text, re.get());
                 // PointTree uses half-open ranges and viewport-relative coordinates.
-                range.start.y -= beg;
-                range.end.y -= beg;
+                range.start.y -= origin;
+                range.end.y -= origin;
                 range.end.x++;
                 intervals.push_back(PointTree::interval(range.start, range.end, 0));
             } while (uregex_findNext(re.get(), &status));
         }
     }
-
-    return PointTree{ std::move(intervals) };
 }
 
 // NOTE: This is the version of AddMark that comes from the UI. The VT api call into this too.
@@ -434,6 +434,20 @@ private:
     //      Either way, we should make this behavior controlled by a setting.
 
     interval_tree::IntervalTree<til::point, size_t> _patternIntervalTree;
+
+    // The results of the last UpdatePatternsUnderLock() scan. Unlike _patternIntervalTree this isn't
+    // cleared while scrolling, and allows the next scan to skip rows that haven't changed since.
+    struct PatternCache
+    {
+        const TextBuffer* buffer = nullptr;
+        TextBuffer::RevisionCursor revision;
+        til::CoordType beg = 0;
+        til::CoordType end = 0;
+        // Relative to `beg`, just like _patternIntervalTree.
+        interval_tree::IntervalTree<til::point, size_t>::interval_vector intervals;
+    };
+    PatternCache _patternCache;
+
     void _clearPatternTree();
     void _InvalidatePatternTree();
     void _InvalidateFromCoords(const til::point start, const til::point end);
@@ -471,6 +485,8 @@ private:
     TextBuffer& _activeBuffer() const noexcept;
     void _updateUrlDetection();
     interval_tree::IntervalTree<til::point, size_t> _getPatterns(til::CoordType beg, til::CoordType end) const;
+    void _findPatterns(interval_tree::IntervalTree<til::point, size_t>::interval_vector& intervals, til::CoordType beg, til::CoordType end, til::CoordType origin) const;
+    interval_tree::IntervalTree<til::point, size_t>::interval_vector _getPatternsCached(til::CoordType beg, til::CoordType end);
 
 #pragma region TextSelection
     // These methods are defined in TerminalSelection.cpp
@@ -86,7 +86,13 @@ void Terminal::SetWindowTitle(const std::wstring_view title)
     _assertLocked();
     if (!_suppressApplicationTitle)
     {
-        _title.emplace(title.empty() ? _startingTitle : title);
+        const std::wstring_view newTitle = title.empty() ? _startingTitle : title;
+        // Prompts often set the same title over and over. There's no need to bother our listeners with that.
+        if (_title && *_title == newTitle)
+        {
+            return;
+        }
+        _title.emplace(newTitle);
         _pfnTitleChanged(_title.value());
     }
 }
@@ -104,22 +104,14 @@ const std::vector<size_t> Terminal::GetPatternId(const til::point location) cons
 {
     _assertLocked();
 
-    // Look through our interval tree for this location
-    const auto intervals = _patternIntervalTree.findOverlapping({ location.x + 1, location.y }, location);
-    if (intervals.size() == 0)
-    {
-        return {};
-    }
-    else
-    {
-        std::vector<size_t> result{};
-        for (const auto& interval : intervals)
-        {
-            result.emplace_back(interval.value);
-        }
-        return result;
-    }
-    return {};
+    // Look through our interval tree for this location.
+    // The renderer calls this for every cell, so we collect the values directly
+    // instead of going through findOverlapping() and its temporary interval_vector.
+    std::vector<size_t> result;
+    _patternIntervalTree.visit_overlapping({ location.x + 1, location.y }, location, [&](const auto& interval) {
+        result.emplace_back(interval.value);
+    });
+    return result;
 }
 
 std::pair<COLORREF, COLORREF> Terminal::GetAttributeColors(const TextAttribute& attr) const noexcept
@@ -124,6 +124,10 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         {
             _KeyMap.insert_or_assign(key, cmdID);
         }
+
+        // The layering is complete at this point. Resolve all key bindings
+        // now so that GetActionByKeyChord() can use the flattened table.
+        _RefreshKeyBindingCaches();
     }
 
     bool ActionMap::FixupsAppliedDuringLoad() const
@@ -406,6 +410,7 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
             }
         }
 
+        _ResolvedKeyToCommandCache = resolvedKeyToActionMap;
         _ResolvedKeyToActionMapCache = single_threaded_map(std::move(resolvedKeyToActionMap));
         _GlobalHotkeysCache = single_threaded_map(std::move(globalHotkeys));
     }
@@ -597,6 +602,11 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
     // - nullptr if the key chord doesn't exist
     Model::Command ActionMap::GetActionByKeyChord(const Control::KeyChord& keys) const
     {
+        if (_ResolvedKeyToActionMapCache)
+        {
+            const auto it = _ResolvedKeyToCommandCache.find(keys);
+            return it != _ResolvedKeyToCommandCache.end() ? it->second : nullptr;
+        }
         return _GetActionByKeyChordInternal(keys).value_or(nullptr);
     }
 
@@ -702,6 +712,12 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
             return false;
         }
 
+        // invalidate caches
+        _CumulativeKeyToActionMapCache.clear();
+        _CumulativeActionToKeyMapCache.clear();
+        _GlobalHotkeysCache = nullptr;
+        _ResolvedKeyToActionMapCache = nullptr;
+
         if (auto oldKeyPair = _KeyMap.find(oldKeys); oldKeyPair != _KeyMap.end())
         {
             // oldKeys is bound in our layer, replace it with newKeys
@@ -726,6 +742,12 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
     // - <none>
     void ActionMap::DeleteKeyBinding(const KeyChord& keys)
     {
+        // invalidate caches
+        _CumulativeKeyToActionMapCache.clear();
+        _CumulativeActionToKeyMapCache.clear();
+        _GlobalHotkeysCache = nullptr;
+        _ResolvedKeyToActionMapCache = nullptr;
+
         if (auto keyPair = _KeyMap.find(keys); keyPair != _KeyMap.end())
         {
             // this keychord is bound in our layer, delete it
@@ -136,6 +136,11 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         // This is effectively a combination of _CumulativeKeyMapCache and _CumulativeActionMapCache and its purpose is so that
         // we can give the SUI a view of the key chords and the commands they map to
         Windows::Foundation::Collections::IMap<Control::KeyChord, Model::Command> _ResolvedKeyToActionMapCache{ nullptr };
+        // _ResolvedKeyToCommandCache holds the same data as _ResolvedKeyToActionMapCache and is valid whenever the latter is non-null.
+        // GetActionByKeyChord() is called for every key press, and this saves it from walking all layers and going through WinRT.
+        // Only this map's own mutations invalidate it. That's fine, because parents aren't modified after _FinalizeInheritance():
+        // the settings UI only edits the user's layer, and a changed settings file results in an entirely new set of ActionMaps.
+        std::unordered_map<Control::KeyChord, Model::Command, KeyChordHash, KeyChordEquality> _ResolvedKeyToCommandCache;
 
         til::shared_mutex<std::unordered_map<hstring, std::vector<Model::Command>>> _cwdLocalSnippetsCache{};
 
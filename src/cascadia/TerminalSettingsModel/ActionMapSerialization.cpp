@@ -43,6 +43,13 @@ namespace winrt::Microsoft::Terminal::Settings::Model::implementation
         // settings phase, so we'll collect them now.
         std::vector<SettingsLoadWarnings> warnings;
 
+        // invalidate caches
+        // (Command blocks go through AddAction(), but keybinding blocks modify _KeyMap directly.)
+        _CumulativeKeyToActionMapCache.clear();
+        _CumulativeActionToKeyMapCache.clear();
+        _GlobalHotkeysCache = nullptr;
+        _ResolvedKeyToActionMapCache = nullptr;
+
         for (const auto& jsonBlock : json)
         {
             if (!jsonBlock.isObject())
@@ -40,6 +40,7 @@ namespace SettingsModelUnitTests
         TEST_METHOD(TestMoveTabArgs);
         TEST_METHOD(TestGetKeyBindingForAction);
         TEST_METHOD(KeybindingsWithoutVkey);
+        TEST_METHOD(ModifyKeybindingsAfterFinalize);
     };
 
     void KeyBindingsTests::KeyChords()
@@ -808,4 +809,77 @@ namespace SettingsModelUnitTests
         const auto action = actionMap->GetActionByKeyChord({ VirtualKeyModifiers::Shift, 0, 255 });
         VERIFY_IS_NOT_NULL(action);
     }
+
+    void KeyBindingsTests::ModifyKeybindingsAfterFinalize()
+    {
+        Log::Comment(L"GetActionByKeyChord() uses the resolved key bindings once they're built."
+                     L" Modifying the ActionMap afterwards must not leave them stale.");
+
+        const std::string parentString{ R"([
+            { "command": "copy", "id": "Test.Copy", "keys": "ctrl+c" },
+            { "command": "paste", "id": "Test.Paste", "keys": "ctrl+v" }
+        ])" };
+        const std::string childString{ R"([ { "command": "closeWindow", "id": "Test.CloseWindow", "keys": "ctrl+w" } ])" };
+        const std::string rebindString{ R"([ { "id": "Test.Paste", "keys": "ctrl+shift+v" } ])" };
+        const std::string unbindString{ R"([ { "command": "unbound", "keys": "ctrl+shift+c" } ])" };
+
+        const auto parentJson = VerifyParseSucceeded(parentString);
+        const auto childJson = VerifyParseSucceeded(childString);
+        const auto rebindJson = VerifyParseSucceeded(rebindString);
+        const auto unbindJson = VerifyParseSucceeded(unbindString);
+
+        const KeyChord ctrlC{ VirtualKeyModifiers::Control, static_cast<int32_t>('C'), 0 };
+        const KeyChord ctrlShiftC{ VirtualKeyModifiers::Control | VirtualKeyModifiers::Shift, static_cast<int32_t>('C'), 0 };
+        const KeyChord ctrlV{ VirtualKeyModifiers::Control, static_cast<int32_t>('V'), 0 };
+        const KeyChord ctrlShiftV{ VirtualKeyModifiers::Control | VirtualKeyModifiers::Shift, static_cast<int32_t>('V'), 0 };
+        const KeyChord ctrlW{ VirtualKeyModifiers::Control, static_cast<int32_t>('W'), 0 };
+
+        const auto parent = winrt::make_self<implementation::ActionMap>();
+        parent->LayerJson(parentJson, OriginTag::User);
+
+        const auto actionMap = winrt::make_self<implementation::ActionMap>();
+        actionMap->LayerJson(childJson, OriginTag::User);
+        actionMap->AddLeastImportantParent(parent);
+        actionMap->_FinalizeInheritance();
+
+        const auto verifyBoundTo = [&](const KeyChord& keys, const wchar_t* id) {
+            const auto cmd = actionMap->GetActionByKeyChord(keys);
+            VERIFY_IS_NOT_NULL(cmd);
+            VERIFY_ARE_EQUAL(cmd.ID(), id);
+            VERIFY_IS_FALSE(actionMap->IsKeyChordExplicitlyUnbound(keys));
+        };
+
+        verifyBoundTo(ctrlC, L"Test.Copy");
+        verifyBoundTo(ctrlV, L"Test.Paste");
+        verifyBoundTo(ctrlW, L"Test.CloseWindow");
+
+        Log::Comment(L"Rebind a key chord from the parent layer");
+        VERIFY_IS_TRUE(actionMap->RebindKeys(ctrlC, ctrlShiftC));
+        VERIFY_IS_NULL(actionMap->GetActionByKeyChord(ctrlC));
+        VERIFY_IS_TRUE(actionMap->IsKeyChordExplicitlyUnbound(ctrlC));
+        verifyBoundTo(ctrlShiftC, L"Test.Copy");
+
+        Log::Comment(L"Delete a key chord from the parent layer");
+        actionMap->KeyBindings();
+        actionMap->DeleteKeyBinding(ctrlV);
+        VERIFY_IS_NULL(actionMap->GetActionByKeyChord(ctrlV));
+        VERIFY_IS_TRUE(actionMap->IsKeyChordExplicitlyUnbound(ctrlV));
+
+        Log::Comment(L"Delete a key chord from our own layer");
+        actionMap->KeyBindings();
+        actionMap->DeleteKeyBinding(ctrlW);
+        VERIFY_IS_NULL(actionMap->GetActionByKeyChord(ctrlW));
+        VERIFY_IS_FALSE(actionMap->IsKeyChordExplicitlyUnbound(ctrlW));
+
+        Log::Comment(L"Bind a key chord with a keybinding block");
+        actionMap->KeyBindings();
+        actionMap->LayerJson(rebindJson, OriginTag::User);
+        verifyBoundTo(ctrlShiftV, L"Test.Paste");
+
+        Log::Comment(L"Unbind a key chord with an unbound command");
+        actionMap->KeyBindings();
+        actionMap->LayerJson(unbindJson, OriginTag::User);
+        VERIFY_IS_NULL(actionMap->GetActionByKeyChord(ctrlShiftC));
+        VERIFY_IS_TRUE(actionMap->IsKeyChordExplicitlyUnbound(ctrlShiftC));
+    }
 }
@@ -11,6 +11,7 @@
 
 using namespace winrt::Microsoft::Terminal::Core;
 using namespace Microsoft::Terminal::Core;
+using namespace Microsoft::Console::Render;
 
 using namespace WEX::Logging;
 using namespace WEX::TestExecution;
@@ -41,6 +42,10 @@ namespace TerminalCoreUnitTests
 
         TEST_METHOD(SetTaskbarProgress);
         TEST_METHOD(SetWorkingDirectory);
+        TEST_METHOD(SetWindowTitleDeduplicates);
+
+        TEST_METHOD(SynchronizedOutputEndsWait);
+        TEST_METHOD(SynchronizedOutputTimesOut);
     };
 };
 
@@ -477,3 +482,77 @@ void TerminalCoreUnitTests::TerminalApiTest::SetWorkingDirectory()
     stateMachine.ProcessString(L"\x1b]9;9;D:\\中文\x1b\\");
     VERIFY_ARE_EQUAL(term.GetWorkingDirectory(), L"D:\\中文");
 }
+
+void TerminalCoreUnitTests::TerminalApiTest::SetWindowTitleDeduplicates()
+{
+    Terminal term{ Terminal::TestDummyMarker{} };
+    DummyRenderer renderer{ &term };
+    term.Create({ 100, 100 }, 0, renderer);
+
+    std::vector<std::wstring> titles;
+    term.SetTitleChangedCallback([&](std::wstring_view title) { titles.emplace_back(title); });
+
+    auto& stateMachine = *(term._stateMachine);
+
+    stateMachine.ProcessString(L"\x1b]0;foo\x1b\\");
+    stateMachine.ProcessString(L"\x1b]2;foo\x1b\\");
+    stateMachine.ProcessString(L"\x1b]0;bar\x1b\\");
+    stateMachine.ProcessString(L"\x1b]0;bar\x1b\\");
+    stateMachine.ProcessString(L"\x1b]0;foo\x1b\\");
+
+    // Repeating the current title shouldn't result in a callback.
+    const std::vector<std::wstring> expected{ L"foo", L"bar", L"foo" };
+    VERIFY_IS_TRUE(expected == titles);
+    VERIFY_ARE_EQUAL(term.GetConsoleTitle(), L"foo");
+}
+
+void TerminalCoreUnitTests::TerminalApiTest::SynchronizedOutputEndsWait()
+{
+    Terminal term{ Terminal::TestDummyMarker{} };
+    DummyRenderer renderer{ &term };
+    term.Create({ 100, 100 }, 0, renderer);
+
+    renderer._renderSettings.SetRenderMode(RenderSettings::Mode::SynchronizedOutput, true);
+    renderer.SynchronizedOutputChanged();
+
+    // The application ends its update from another thread, just like the output thread would.
+    std::thread application{ [&]() {
+        Sleep(10);
+        term.LockConsole();
+        renderer._renderSettings.SetRenderMode(RenderSettings::Mode::SynchronizedOutput, false);
+        renderer.SynchronizedOutputChanged();
+        term.UnlockConsole();
+    } };
+
+    term.LockConsole();
+    const auto finished = renderer.WaitForSynchronizedOutput();
+    term.UnlockConsole();
+    application.join();
+
+    VERIFY_IS_TRUE(finished);
+    VERIFY_IS_FALSE(renderer._renderSettings.GetRenderMode(RenderSettings::Mode::SynchronizedOutput));
+}
+
+void TerminalCoreUnitTests::TerminalApiTest::SynchronizedOutputTimesOut()
+{
+    Terminal term{ Terminal::TestDummyMarker{} };
+    DummyRenderer renderer{ &term };
+    term.Create({ 100, 100 }, 0, renderer);
+
+    renderer._renderSettings.SetRenderMode(RenderSettings::Mode::SynchronizedOutput, true);
+    renderer.SynchronizedOutputChanged();
+
+    term.LockConsole();
+    const auto beg = GetTickCount64();
+    const auto finished = renderer.WaitForSynchronizedOutput();
+    const auto elapsed = GetTickCount64() - beg;
+    // Once timed out, the renderer doesn't wait again until the mode is set anew.
+    const auto finishedAfterTimeout = renderer.WaitForSynchronizedOutput();
+    term.UnlockConsole();
+
+    VERIFY_IS_FALSE(finished);
+    VERIFY_IS_GREATER_THAN_OR_EQUAL(elapsed, 100ull);
+    VERIFY_IS_TRUE(finishedAfterTimeout);
+    // Only the application may reset the mode, so it still reports as set after the timeout.
+    VERIFY_IS_TRUE(renderer._renderSettings.GetRenderMode(RenderSettings::Mode::SynchronizedOutput));
+}
@@ -53,6 +53,8 @@ class TerminalCoreUnitTests::TerminalBufferTests final
 
     TEST_METHOD(TestURLPatternDetection);
 
+    TEST_METHOD(TestURLPatternDetectionIncremental);
+
     TEST_METHOD_SETUP(MethodSetup)
     {
         // STEP 1: Set up the Terminal
@@ -634,3 +636,32 @@ void TerminalBufferTests::TestURLPatternDetection()
     result = term->GetHyperlinkAtBufferPosition(til::point{ urlEndX + 1, 0 });
     VERIFY_IS_TRUE(result.empty(), L"URL is not detected after the actual URL.");
 }
+
+void TerminalBufferTests::TestURLPatternDetectionIncremental()
+{
+    // This is off by default; turn it on for the test.
+    auto originalDetectURLs = term->_detectURLs;
+    auto restoreDetectUrls = wil::scope_exit([&]() {
+        term->_detectURLs = originalDetectURLs;
+    });
+    term->_detectURLs = true;
+
+    auto& termSm = *term->_stateMachine;
+
+    Log::Comment(L"Detect a URL in the first row.");
+    termSm.ProcessString(L"https://a.contoso.com\r\n");
+    term->UpdatePatternsUnderLock();
+    VERIFY_ARE_EQUAL(L"https://a.contoso.com", term->GetHyperlinkAtBufferPosition(til::point{ 0, 0 }));
+
+    Log::Comment(L"The unchanged first row keeps its URL, while the new one in the second row is detected.");
+    termSm.ProcessString(L"https://b.contoso.com");
+    term->UpdatePatternsUnderLock();
+    VERIFY_ARE_EQUAL(L"https://a.contoso.com", term->GetHyperlinkAtBufferPosition(til::point{ 0, 0 }));
+    VERIFY_ARE_EQUAL(L"https://b.contoso.com", term->GetHyperlinkAtBufferPosition(til::point{ 0, 1 }));
+
+    Log::Comment(L"Overwriting the first row removes its URL.");
+    termSm.ProcessString(L"\x1b[H\x1b[2K");
+    term->UpdatePatternsUnderLock();
+    VERIFY_IS_TRUE(term->GetHyperlinkAtBufferPosition(til::point{ 0, 0 }).empty());
+    VERIFY_ARE_EQUAL(L"https://b.contoso.com", term->GetHyperlinkAtBufferPosition(til::point{ 0, 1 }));
+}
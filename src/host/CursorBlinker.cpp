@@ -37,14 +37,19 @@ CursorBlinker::~CursorBlinker()
 
 void CursorBlinker::UpdateSystemMetrics() noexcept
 {
+    const auto sysConfig = ServiceLocator::LocateSystemConfigurationProvider();
+
     // This can be -1 in a TS session
-    _uCaretBlinkTime = ServiceLocator::LocateSystemConfigurationProvider()->GetCaretBlinkTime();
+    _uCaretBlinkTime = sysConfig->GetCaretBlinkTime();
+    // Every blink is a repaint that has to be sent over the network in a remote session.
+    // Not all clients ask for an infinite blink time, so we check for it ourselves.
+    _remoteSession = sysConfig->IsRemoteSession();
 
     // If animations are disabled, or the blink rate is infinite, blinking is not allowed.
     auto animationsEnabled = TRUE;
     SystemParametersInfoW(SPI_GETCLIENTAREAANIMATION, 0, &animationsEnabled, 0);
     auto& renderSettings = ServiceLocator::LocateGlobals().getConsoleInformation().GetRenderSettings();
-    renderSettings.SetRenderMode(RenderSettings::Mode::BlinkAllowed, animationsEnabled && _uCaretBlinkTime != INFINITE);
+    renderSettings.SetRenderMode(RenderSettings::Mode::BlinkAllowed, animationsEnabled && _uCaretBlinkTime != INFINITE && !_remoteSession);
 }
 
 void CursorBlinker::SettingsChanged() noexcept
@@ -137,6 +142,7 @@ void CursorBlinker::TimerRoutine(SCREEN_INFORMATION& ScreenInfo) const noexcept
     // Don't blink the cursor for remote sessions.
     if ((!ServiceLocator::LocateSystemConfigurationProvider()->IsCaretBlinkingEnabled() ||
          _uCaretBlinkTime == -1 ||
+         _remoteSession ||
          (!cursor.IsBlinkingAllowed())) &&
         cursor.IsOn())
     {
@@ -33,5 +33,6 @@ namespace Microsoft::Console
 
         wil::unique_threadpool_timer_nowait _timer;
         UINT _uCaretBlinkTime;
+        bool _remoteSession = false;
     };
 }
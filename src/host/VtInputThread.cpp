@@ -111,6 +111,12 @@ void VtInputThread::_InputThread()
                 LockConsole();
                 const auto unlock = wil::scope_exit([&] { UnlockConsole(); });
 
+                // A single read may contain hundreds of keys. Wake up readers
+                // once for all of them instead of once per key.
+                auto& inputBuffer = *ServiceLocator::LocateGlobals().getConsoleInformation().pInputBuffer;
+                inputBuffer.DeferReaderWakeup();
+                const auto resume = wil::scope_exit([&] { inputBuffer.ResumeReaderWakeup(); });
+
                 _pInputStateMachine->ProcessString(wstr);
             }
             CATCH_LOG();
@@ -194,7 +194,16 @@ bool VtIo::IsUsingVt() const
         // Allow the input thread to momentarily gain the console lock.
         auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
         const auto suspension = gci.SuspendLock();
+        const auto start = std::chrono::steady_clock::now();
         _deviceAttributes = _pVtInputThread->WaitUntilDA1(3000);
+        const auto waited = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+        TraceLoggingWrite(
+            g_hConhostV2EventTraceProvider,
+            "ConPTY DA1 wait",
+            TraceLoggingInt64(waited.count(), "milliseconds"),
+            TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+            TraceLoggingKeyword(TIL_KEYWORD_TRACE));
     }
 
     if (_pPtySignalInputThread)
@@ -306,6 +315,21 @@ static constexpr bool IsControlCharacter(wchar_t wch) noexcept
     return (wch <= 0x1f) | (static_cast<wchar_t>(wch - 0x7f) <= 0x20);
 }
 
+// Appends ";" followed by the given SGR color parameter, which is always in the range [30,107].
+// This gets called up to twice for every attribute change, which is why it avoids fmt.
+static char* formatColorParameter(char* out, uint8_t value) noexcept
+{
+    *out++ = ';';
+    if (value >= 100)
+    {
+        *out++ = '1';
+        value -= 100;
+    }
+    *out++ = static_cast<char>('0' + value / 10);
+    *out++ = static_cast<char>('0' + value % 10);
+    return out;
+}
+
 // Formats the given console attributes to their closest VT equivalent.
 // `out` must refer to at least `formatAttributesMaxLen` characters of valid memory.
 // Returns a pointer past the end.
@@ -333,14 +357,14 @@ static char* formatAttributes(char* out, const TextAttribute& attributes) noexce
     if (attributes.GetForeground().IsLegacy())
     {
         const uint8_t index = sgr[attributes.GetForeground().GetIndex()];
-        out = fmt::format_to(out, FMT_COMPILE(";{}"), index);
+        out = formatColorParameter(out, index);
     }
 
     // 4 bytes (";107").
     if (attributes.GetBackground().IsLegacy())
     {
         const uint8_t index = sgr[attributes.GetBackground().GetIndex()] + 10;
-        out = fmt::format_to(out, FMT_COMPILE(";{}"), index);
+        out = formatColorParameter(out, index);
     }
 
     // 1 byte.
@@ -792,6 +816,71 @@ void VtIo::Writer::WriteInfos(til::point target, std::span<const CHAR_INFO> info
     }
 }
 
+// Same as WriteInfos(), but skips over cells that `row` (the row the infos are about to be written to) already
+// contains exactly as given. Legacy TUIs tend to redraw the entire screen with WriteConsoleOutputW, even if
+// only a few cells changed. Since the terminal mirrors our buffer, there's no need to send the others again.
+void VtIo::Writer::WriteChangedInfos(const ROW& row, til::point target, std::span<const CHAR_INFO> infos) const
+{
+    // Gaps of unchanged cells shorter than this are written anyway,
+    // because a CUP and SGR sequence would be longer than the cells themselves.
+    static constexpr size_t minGap = 8;
+
+    // We don't know how the terminal treats text written on top of images. Play it safe.
+    if (row.GetImageSlice())
+    {
+        WriteInfos(target, infos);
+        return;
+    }
+
+    // Only narrow glyphs are compared. Wide glyphs and their halves always count as changed,
+    // which means that spans below never begin or end in the middle of a wide glyph.
+    const auto unchanged = [&](size_t i) {
+        const auto& ci = til::at(infos, i);
+        const auto column = target.x + gsl::narrow_cast<til::CoordType>(i);
+        if (WI_IsAnyFlagSet(ci.Attributes, COMMON_LVB_LEADING_BYTE | COMMON_LVB_TRAILING_BYTE) ||
+            row.DbcsAttrAt(column) != DbcsAttribute::Single)
+        {
+            return false;
+        }
+        const auto glyph = row.GlyphAt(column);
+        return glyph.size() == 1 && til::at(glyph, 0) == ci.Char.UnicodeChar && row.GetAttrByColumn(column) == TextAttribute{ ci.Attributes };
+    };
+
+    const auto size = infos.size();
+    size_t beg = 0;
+
+    for (;;)
+    {
+        while (beg < size && unchanged(beg))
+        {
+            beg++;
+        }
+        if (beg >= size)
+        {
+            break;
+        }
+
+        // Extend the span until we find a gap of unchanged cells that's worth skipping.
+        auto end = beg + 1;
+        while (end < size)
+        {
+            auto gapEnd = end;
+            while (gapEnd < size && unchanged(gapEnd))
+            {
+                gapEnd++;
+            }
+            if (gapEnd >= size || gapEnd - end >= minGap)
+            {
+                break;
+            }
+            end = gapEnd + 1;
+        }
+
+        WriteInfos({ target.x + gsl::narrow_cast<til::CoordType>(beg), target.y }, infos.subspan(beg, end - beg));
+        beg = end;
+    }
+}
+
 void VtIo::Writer::WriteScreenInfo(SCREEN_INFORMATION& newContext, til::size oldSize) const
 {
     const auto area = static_cast<size_t>(oldSize.width * oldSize.height);
@@ -821,7 +910,37 @@ void VtIo::Writer::WriteScreenInfo(SCREEN_INFORMATION& newContext, til::size old
         THROW_IF_FAILED(ReadConsoleOutputWImplHelper(screenInfo, infos, request, read));
         for (til::CoordType i = 0; i < oldSize.height; i++)
         {
-            WriteInfos({ 0, i }, { infos.begin() + i * oldSize.width, static_cast<size_t>(oldSize.width) });
+            const std::span<const CHAR_INFO> row{ infos.begin() + i * oldSize.width, static_cast<size_t>(oldSize.width) };
+
+            // Most rows end in blanks. Instead of writing them one by one, we can erase them with a single EL.
+            // EL only applies the background color however, so this only works for blanks without meta attributes.
+            const auto blank = row.empty() ? CHAR_INFO{} : row.back();
+            auto len = row.size();
+            if (blank.Char.UnicodeChar == L' ' && (blank.Attributes & ~(FG_ATTRS | BG_ATTRS)) == 0)
+            {
+                while (len > 0 && row[len - 1].Char.UnicodeChar == L' ' && row[len - 1].Attributes == blank.Attributes)
+                {
+                    len--;
+                }
+            }
+
+            if (len == 0)
+            {
+                WriteCUP({ 0, i });
+            }
+            else
+            {
+                WriteInfos({ 0, i }, row.first(len));
+            }
+
+            if (len != row.size())
+            {
+                if (len == 0 || row[len - 1].Attributes != blank.Attributes)
+                {
+                    WriteAttributes(TextAttribute{ blank.Attributes });
+                }
+                WriteUTF8("\x1b[K");
+            }
         }
 
         WriteCUP(screenInfo.GetTextBuffer().GetCursor().GetPosition());
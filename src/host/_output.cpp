@@ -64,6 +64,57 @@ struct FillConsoleResult
     til::CoordType cellsModified = 0;
 };
 
+// Fills the buffer with a single attribute or ASCII character one row segment at a time.
+// This avoids OutputCellIterator, which would otherwise yield and write each cell individually.
+// Neither of the two changes the width of any glyph, so lengthRead and cellsModified are identical.
+static til::CoordType FillConsoleRows(TextBuffer& textBuffer, FillConsoleMode mode, const uint16_t value, const size_t lengthToWrite, const til::point startingCoordinate)
+{
+    const auto size = textBuffer.GetSize();
+    const auto w = size.Width();
+    const auto h = size.Height();
+    const auto attr = mode == FillConsoleMode::FillAttribute ? TextAttribute{ value } : TextAttribute{};
+    const std::wstring fill(mode == FillConsoleMode::FillCharacter ? gsl::narrow_cast<size_t>(w) : 0, static_cast<wchar_t>(value));
+    auto remaining = lengthToWrite;
+    auto y = startingCoordinate.y;
+    til::CoordType cellsModified = 0;
+
+    for (auto x = startingCoordinate.x; y < h && remaining != 0; x = 0, ++y)
+    {
+        const auto columns = gsl::narrow_cast<til::CoordType>(std::min<size_t>(remaining, gsl::narrow_cast<size_t>(w - x)));
+        auto& row = textBuffer.GetMutableRowByOffset(y);
+        auto dirtyBeg = x;
+        auto dirtyEnd = x + columns;
+
+        if (mode == FillConsoleMode::FillAttribute)
+        {
+            row.ReplaceAttributes(x, x + columns, attr);
+        }
+        else
+        {
+            RowWriteState state{
+                .text = { fill.data(), gsl::narrow_cast<size_t>(columns) },
+                .columnBegin = x,
+                .columnLimit = x + columns,
+            };
+            row.ReplaceText(state);
+            dirtyBeg = state.columnBeginDirty;
+            dirtyEnd = state.columnEndDirty;
+
+            // Same as ROW::WriteCells() with wrap=false: filling the last column unwraps the row.
+            if (x + columns == w)
+            {
+                row.SetWrapForced(false);
+            }
+        }
+
+        textBuffer.TriggerRedraw(Viewport::FromExclusive({ dirtyBeg, y, dirtyEnd, y + 1 }));
+        remaining -= gsl::narrow_cast<size_t>(columns);
+        cellsModified += columns;
+    }
+
+    return cellsModified;
+}
+
 static FillConsoleResult FillConsoleImpl(SCREEN_INFORMATION& screenInfo, FillConsoleMode mode, const void* data, const size_t lengthToWrite, const til::point startingCoordinate)
 {
     if (lengthToWrite == 0)
@@ -199,6 +250,15 @@ static FillConsoleResult FillConsoleImpl(SCREEN_INFORMATION& screenInfo, FillCon
 
         writer.Submit();
     }
+    else if (const auto value = *static_cast<const uint16_t*>(data);
+             mode == FillConsoleMode::FillAttribute || (mode == FillConsoleMode::FillCharacter && value < 0x80))
+    {
+        result.cellsModified = FillConsoleRows(screenBuffer.GetTextBuffer(), mode, value, lengthToWrite, startingCoordinate);
+        result.lengthRead = gsl::narrow_cast<size_t>(result.cellsModified);
+
+        // If we've overwritten image content, it needs to be erased.
+        ImageSlice::EraseCells(screenInfo.GetTextBuffer(), startingCoordinate, result.cellsModified);
+    }
     else
     {
         // Technically we could always pass `data` as `uint16_t*`, because `wchar_t` is guaranteed to be 16 bits large.
@@ -3,6 +3,8 @@
 
 #include "precomp.h"
 
+#include <bit>
+
 #include "ApiRoutines.h"
 
 #include "_stream.h"
@@ -31,6 +33,45 @@ constexpr bool controlCharPredicate(wchar_t wch)
     return wch < L' ' || wch == 0x007F;
 }
 
+// Equivalent to std::find_if(beg, end, controlCharPredicate).
+// Most legacy output consists of long runs of plain text, so this checks 8 characters at a time.
+static const wchar_t* findNextControlChar(const wchar_t* beg, const wchar_t* end) noexcept
+{
+#if defined(TIL_SSE_INTRINSICS)
+    const auto maxC0 = _mm_set1_epi16(0x1F);
+    const auto del = _mm_set1_epi16(0x7F);
+    const auto zero = _mm_setzero_si128();
+    for (; end - beg >= 8; beg += 8)
+    {
+        const auto vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(beg));
+        // SSE2 lacks unsigned 16-bit comparisons, but a saturated subtraction results in 0 exactly for [0,0x1F].
+        const auto c0 = _mm_cmpeq_epi16(_mm_subs_epu16(vec, maxC0), zero);
+        const auto mask = static_cast<unsigned int>(_mm_movemask_epi8(_mm_or_si128(c0, _mm_cmpeq_epi16(vec, del))));
+        if (mask)
+        {
+            // Each wchar_t contributes 2 bits to the mask.
+            return beg + std::countr_zero(mask) / 2;
+        }
+    }
+#elif defined(TIL_ARM_NEON_INTRINSICS)
+    const auto space = vdupq_n_u16(L' ');
+    const auto del = vdupq_n_u16(0x7F);
+    for (; end - beg >= 8; beg += 8)
+    {
+        const auto vec = vld1q_u16(reinterpret_cast<const uint16_t*>(beg));
+        if (vmaxvq_u16(vorrq_u16(vcltq_u16(vec, space), vceqq_u16(vec, del))) != 0)
+        {
+            break;
+        }
+    }
+#endif
+
+    for (; beg != end && !controlCharPredicate(*beg); ++beg)
+    {
+    }
+    return beg;
+}
+
 // Routine Description:
 // - This routine updates the cursor position.  Its input is the non-special
 //   cased new location of the cursor.  For example, if the cursor were being
@@ -211,7 +252,8 @@ void WriteCharsLegacy(SCREEN_INFORMATION& screenInfo, const std::wstring_view& t
 
     while (it != end)
     {
-        const auto nextControlChar = std::find_if(it, end, controlCharPredicate);
+        const auto itPtr = text.data() + (it - beg);
+        const auto nextControlChar = it + (findNextControlChar(itPtr, text.data() + text.size()) - itPtr);
         if (nextControlChar != it)
         {
             const std::wstring_view chunk{ it, nextControlChar };
@@ -526,9 +568,21 @@ NT_CATCH_RETURN()
         const auto codepage{ consoleInfo.OutputCP };
         auto leadByteCaptured{ false };
         auto leadByteConsumed{ false };
-        std::wstring wstr{};
+        // Both of these are protected by the console lock. Reusing the conversion buffer
+        // across calls avoids a heap allocation for every single WriteConsoleA call.
+        static std::wstring wstr{};
         static til::u8state u8State{};
 
+        // A single huge write shouldn't keep its buffer around for the lifetime of the process.
+        // This runs before `unlock`, because it's declared after it.
+        static constexpr size_t maxRetainedCapacity = 64 * 1024;
+        const auto trimBuffer = wil::scope_exit([&] {
+            if (wstr.capacity() > maxRetainedCapacity)
+            {
+                wstr = std::wstring{};
+            }
+        });
+
         // Convert our input parameters to Unicode
         if (codepage == CP_UTF8)
         {
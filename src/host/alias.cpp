@@ -898,7 +898,10 @@ std::wstring Alias::s_MatchAndCopyAlias(std::wstring_view sourceText, std::wstri
         return {};
     }
 
+    // The expansion is usually about as long as the target plus the arguments.
+    // Reserving that upfront avoids growing the buffer while we push_back() single characters.
     std::wstring buffer;
+    buffer.reserve(target.size() + sourceText.size() + 2);
     size_t lines = 0;
 
     for (auto it = target.begin(), end = target.end(); it != end;)
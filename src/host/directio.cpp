@@ -420,7 +420,6 @@ CATCH_RETURN();
 {
     try
     {
-        const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
         auto& storageBuffer = context.GetActiveBuffer();
         const auto storageRectangle = storageBuffer.GetBufferSize();
         const auto clippedRectangle = storageRectangle.Clamp(requestRectangle);
@@ -432,7 +431,6 @@ CATCH_RETURN();
         }
 
         const auto bufferStride = gsl::narrow_cast<size_t>(std::max(0, requestRectangle.Width()));
-        const auto width = gsl::narrow_cast<size_t>(clippedRectangle.Width());
         const auto offsetY = clippedRectangle.Top() - requestRectangle.Top();
         const auto offsetX = clippedRectangle.Left() - requestRectangle.Left();
         // We always write the intersection between the valid `storageRectangle` and the given `requestRectangle`.
@@ -446,14 +444,41 @@ CATCH_RETURN();
             return E_INVALIDARG;
         }
 
+        const auto& textBuffer = storageBuffer.GetTextBuffer();
+        const auto left = clippedRectangle.Left();
+        const auto right = clippedRectangle.RightExclusive();
+
         for (til::CoordType y = clippedRectangle.Top(); y <= clippedRectangle.BottomInclusive(); y++)
         {
-            auto it = storageBuffer.GetCellDataAt({ clippedRectangle.Left(), y });
+            const auto& row = textBuffer.GetRowByOffset(y);
+            auto runBeg = 0;
 
-            for (size_t i = 0; i < width; i++)
+            // This reads the ROW directly instead of going through a TextBufferCellIterator,
+            // so that we only need to convert each attribute run into its legacy form once.
+            for (const auto& run : row.Attributes().runs())
             {
-                targetBuffer[totalOffset + i] = gci.AsCharInfo(*it);
-                ++it;
+                const auto runEnd = runBeg + run.length;
+                const auto beg = std::max(runBeg, left);
+                const auto end = std::min(runEnd, right);
+
+                if (beg < end)
+                {
+                    const auto legacyAttributes = run.value.GetLegacyAttributes();
+
+                    for (auto x = beg; x < end; x++)
+                    {
+                        auto& ci = targetBuffer[totalOffset + gsl::narrow_cast<size_t>(x - left)];
+                        ci.Char.UnicodeChar = Utf16ToUcs2(row.GlyphAt(x));
+                        ci.Attributes = legacyAttributes | GeneratePublicApiAttributeFormat(row.DbcsAttrAt(x));
+                    }
+                }
+
+                if (runEnd >= right)
+                {
+                    break;
+                }
+
+                runBeg = runEnd;
             }
 
             totalOffset += bufferStride;
@@ -506,7 +531,8 @@ CATCH_RETURN();
                                                     std::span<const CHAR_INFO> buffer,
                                                     til::CoordType bufferStride,
                                                     const Viewport& requestRectangle,
-                                                    Viewport& writtenRectangle) noexcept
+                                                    Viewport& writtenRectangle,
+                                                    bool skipUnchangedCells) noexcept
 {
     try
     {
@@ -547,14 +573,22 @@ CATCH_RETURN();
             const auto charInfos = buffer.subspan(totalOffset, width);
             const til::point target{ clippedRectangle.Left(), y };
 
-            // Make the iterator and write to the target position.
-            storageBuffer.Write(OutputCellIterator(charInfos), target);
-
+            // This needs to happen before we write to the buffer, so that we can compare against its old contents.
             if (writer)
             {
-                writer.WriteInfos(target, charInfos);
+                if (skipUnchangedCells)
+                {
+                    writer.WriteChangedInfos(storageBuffer.GetTextBuffer().GetRowByOffset(y), target, charInfos);
+                }
+                else
+                {
+                    writer.WriteInfos(target, charInfos);
+                }
             }
 
+            // Make the iterator and write to the target position.
+            storageBuffer.Write(OutputCellIterator(charInfos), target);
+
             totalOffset += bufferStride;
         }
 
@@ -595,7 +629,7 @@ CATCH_RETURN();
         const auto codepage = gci.OutputCP;
         LOG_IF_FAILED(_ConvertCellsToWInplace(codepage, buffer, requestRectangle));
 
-        RETURN_IF_FAILED(WriteConsoleOutputWImplHelper(context, buffer, requestRectangle.Width(), requestRectangle, writtenRectangle));
+        RETURN_IF_FAILED(WriteConsoleOutputWImplHelper(context, buffer, requestRectangle.Width(), requestRectangle, writtenRectangle, true));
 
         if (writer)
         {
@@ -625,7 +659,7 @@ CATCH_RETURN();
             writer.BackupCursor();
         }
 
-        RETURN_IF_FAILED(WriteConsoleOutputWImplHelper(context, buffer, requestRectangle.Width(), requestRectangle, writtenRectangle));
+        RETURN_IF_FAILED(WriteConsoleOutputWImplHelper(context, buffer, requestRectangle.Width(), requestRectangle, writtenRectangle, true));
 
         if (writer)
         {
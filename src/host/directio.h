@@ -29,7 +29,8 @@ class SCREEN_INFORMATION;
                                                     std::span<const CHAR_INFO> buffer,
                                                     til::CoordType bufferStride,
                                                     const Microsoft::Console::Types::Viewport& requestRectangle,
-                                                    Microsoft::Console::Types::Viewport& writtenRectangle) noexcept;
+                                                    Microsoft::Console::Types::Viewport& writtenRectangle,
+                                                    bool skipUnchangedCells = false) noexcept;
 
 [[nodiscard]] NTSTATUS ConsoleCreateScreenBuffer(std::unique_ptr<ConsoleHandleData>& handle,
                                                  _In_ PCONSOLE_API_MSG Message,
@@ -295,9 +295,37 @@ void InputBuffer::ReinitializeInputBuffer()
 // - None
 void InputBuffer::WakeUpReadersWaitingForData()
 {
+    if (_readerWakeupDeferred)
+    {
+        _readerWakeupPending = true;
+        return;
+    }
     WaitQueue.NotifyWaiters(false);
 }
 
+// Routine Description:
+// - Suspends WakeUpReadersWaitingForData() until ResumeReaderWakeup() is called.
+//   The VT input thread writes every key of a win32-input-mode burst or a paste
+//   individually and each write would otherwise run all pending cooked reads.
+// - The console lock must be held between the two calls.
+void InputBuffer::DeferReaderWakeup() noexcept
+{
+    _readerWakeupDeferred = true;
+}
+
+// Routine Description:
+// - Counterpart to DeferReaderWakeup(). Wakes up readers once if any write happened in between.
+void InputBuffer::ResumeReaderWakeup() noexcept
+try
+{
+    _readerWakeupDeferred = false;
+    if (std::exchange(_readerWakeupPending, false))
+    {
+        WakeUpReadersWaitingForData();
+    }
+}
+CATCH_LOG()
+
 // Routine Description:
 // - Wakes up any readers waiting for data when a ctrl-c or ctrl-break is input.
 // Arguments:
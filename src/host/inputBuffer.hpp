@@ -41,6 +41,8 @@ public:
 
     void ReinitializeInputBuffer();
     void WakeUpReadersWaitingForData();
+    void DeferReaderWakeup() noexcept;
+    void ResumeReaderWakeup() noexcept;
     void TerminateRead(_In_ WaitTerminationReason Flag);
     size_t GetNumberOfReadyEvents() const noexcept;
     void Flush();
@@ -90,6 +92,10 @@ private:
     // Otherwise, we should be calling them.
     bool _vtInputShouldSuppress{ false };
 
+    // See DeferReaderWakeup().
+    bool _readerWakeupDeferred = false;
+    bool _readerWakeupPending = false;
+
     void _switchReadingMode(ReadingMode mode);
     void _switchReadingModeSlowPath(ReadingMode mode);
     void _WriteBuffer(const std::span<const INPUT_RECORD>& inRecords, _Out_ size_t& eventsWritten, _Out_ bool& setWaitEvent);
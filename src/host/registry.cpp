@@ -123,7 +123,7 @@ void Registry::GetEditKeys(_In_opt_ HKEY hConsoleKey) const
 
 void Registry::_LoadMappedProperties(_In_reads_(cPropertyMappings) const RegistrySerialization::RegPropertyMap* const rgPropertyMappings,
                                      const size_t cPropertyMappings,
-                                     const HKEY hKey)
+                                     const RegistrySerialization::ValueSnapshot& values)
 {
     // Iterate through properties table and load each setting for common property types
     for (UINT iMapping = 0; iMapping < cPropertyMappings; iMapping++)
@@ -140,12 +140,12 @@ void Registry::_LoadMappedProperties(_In_reads_(cPropertyMappings) const Registr
         case RegistrySerialization::_RegPropertyType::Byte:
         case RegistrySerialization::_RegPropertyType::Coordinate:
         {
-            Status = RegistrySerialization::s_LoadRegDword(hKey, pPropMap, _pSettings);
+            Status = RegistrySerialization::s_LoadRegDword(values, pPropMap, _pSettings);
             break;
         }
         case RegistrySerialization::_RegPropertyType::String:
         {
-            Status = RegistrySerialization::s_LoadRegString(hKey, pPropMap, _pSettings);
+            Status = RegistrySerialization::s_LoadRegString(values, pPropMap, _pSettings);
             break;
         }
         }
@@ -158,6 +158,15 @@ void Registry::_LoadMappedProperties(_In_reads_(cPropertyMappings) const Registr
     }
 }
 
+const RegistrySerialization::ValueSnapshot& Registry::_ConsoleKeyValues(const HKEY hConsoleKey)
+{
+    if (!_consoleKeyValues)
+    {
+        _consoleKeyValues.emplace(hConsoleKey);
+    }
+    return *_consoleKeyValues;
+}
+
 // Routine Description:
 // - Read settings that apply to all console instances from the registry.
 // Arguments:
@@ -172,7 +181,7 @@ void Registry::LoadGlobalsFromRegistry()
 
     if (SUCCEEDED_NTSTATUS(status))
     {
-        _LoadMappedProperties(RegistrySerialization::s_GlobalPropMappings, RegistrySerialization::s_GlobalPropMappingsSize, hConsoleKey);
+        _LoadMappedProperties(RegistrySerialization::s_GlobalPropMappings, RegistrySerialization::s_GlobalPropMappingsSize, _ConsoleKeyValues(hConsoleKey));
 
         RegCloseKey((HKEY)hConsoleKey);
         RegCloseKey((HKEY)hCurrentUserKey);
@@ -243,14 +252,18 @@ void Registry::LoadFromRegistry(_In_ PCWSTR const pwszConsoleTitle)
         return;
     }
 
+    // An empty title refers to the console key itself.
+    std::optional<RegistrySerialization::ValueSnapshot> titleKeyValues;
+    const auto& values = *pwszConsoleTitle ? titleKeyValues.emplace(hTitleKey) : _ConsoleKeyValues(hConsoleKey);
+
     // Iterate through properties table and load each setting for common property types
-    _LoadMappedProperties(RegistrySerialization::s_PropertyMappings, RegistrySerialization::s_PropertyMappingsSize, hTitleKey);
+    _LoadMappedProperties(RegistrySerialization::s_PropertyMappings, RegistrySerialization::s_PropertyMappingsSize, values);
 
     // Now load complex properties
     // Some properties shouldn't be filled by the registry if a copy already exists from the process start information.
-    const auto loadDWORD = [=](const auto valueName) {
+    const auto loadDWORD = [&](const auto valueName) {
         DWORD value;
-        const auto status = RegistrySerialization::s_QueryValue(hTitleKey, valueName, sizeof(value), REG_DWORD, (PBYTE)&value, nullptr);
+        const auto status = values.QueryValue(valueName, sizeof(value), REG_DWORD, (PBYTE)&value, nullptr);
         return SUCCEEDED_NTSTATUS(status) ? std::optional{ value } : std::nullopt;
     };
 
@@ -35,7 +35,11 @@ public:
 private:
     void _LoadMappedProperties(_In_reads_(cPropertyMappings) const RegistrySerialization::RegPropertyMap* const rgPropertyMappings,
                                const size_t cPropertyMappings,
-                               const HKEY hKey);
+                               const RegistrySerialization::ValueSnapshot& values);
+    const RegistrySerialization::ValueSnapshot& _ConsoleKeyValues(const HKEY hConsoleKey);
 
     Settings* const _pSettings;
+    // The root console key is read by LoadGlobalsFromRegistry and LoadDefaultFromRegistry,
+    // which are called back to back during startup. This avoids enumerating it twice.
+    std::optional<RegistrySerialization::ValueSnapshot> _consoleKeyValues;
 };
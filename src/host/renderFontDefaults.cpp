@@ -7,20 +7,28 @@
 
 #pragma hdrstop
 
-RenderFontDefaults::RenderFontDefaults()
-{
-    LOG_IF_NTSTATUS_FAILED(TrueTypeFontList::s_Initialize());
-}
+RenderFontDefaults::RenderFontDefaults() = default;
 
 RenderFontDefaults::~RenderFontDefaults()
 {
-    LOG_IF_FAILED(TrueTypeFontList::s_Destroy());
+    if (_initialized)
+    {
+        LOG_IF_FAILED(TrueTypeFontList::s_Destroy());
+    }
 }
 
 [[nodiscard]] HRESULT RenderFontDefaults::RetrieveDefaultFontNameForCodepage(const unsigned int codePage,
                                                                              std::wstring& outFaceName)
 try
 {
+    // The TrueType font list is read from the registry. Most sessions (in particular ConPTY ones)
+    // never ask for a default font, so we defer loading it until the first time it's needed.
+    if (!_initialized)
+    {
+        _initialized = true;
+        LOG_IF_NTSTATUS_FAILED(TrueTypeFontList::s_Initialize());
+    }
+
     // GH#3123: Propagate font length changes up through Settings and propsheet
     wchar_t faceName[LF_FACESIZE]{ 0 };
     auto status = TrueTypeFontList::s_SearchByCodePage(codePage, faceName, ARRAYSIZE(faceName));
@@ -49,7 +49,8 @@ try
 
     // Check if this conhost is allowed to delegate its activities to another.
     // If so, look up the registered default console handler.
-    if (Globals.delegationPair.IsUndecided())
+    // ConPTY sessions never hand off (see _shouldAttemptHandoff), so we can skip the registry lookup.
+    if (Globals.delegationPair.IsUndecided() && !args->IsHeadless())
     {
         Globals.delegationPair = DelegationConfig::s_GetDelegationPair();
 
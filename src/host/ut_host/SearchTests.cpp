@@ -201,4 +201,51 @@ class SearchTests
         s.Reset(gci.renderData, L"(?i)ab", SearchFlag::RegularExpression, false);
         DoFoundChecks(s, {}, 1, false);
     }
+
+    TEST_METHOD(IncrementalUpdate)
+    {
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+        auto& textBuffer = gci.GetActiveOutputBuffer().GetTextBuffer();
+
+        Search s;
+        s.Reset(gci.renderData, L"AB", SearchFlag::None, false);
+        VERIFY_ARE_EQUAL(4u, s.Results().size());
+
+        // Add another match below the existing ones and scroll the first one out of the buffer.
+        RowWriteState state{ .text = L"xxAB" };
+        textBuffer.Replace(5, {}, state);
+        textBuffer.IncrementCircularBuffer();
+
+        // The second Reset() with the same needle only searches through the rows that changed.
+        s.Reset(gci.renderData, L"AB", SearchFlag::None, false);
+
+        Search expected;
+        expected.Reset(gci.renderData, L"AB", SearchFlag::None, false);
+
+        const std::vector<til::point_span> results{
+            { { 0, 0 }, { 1, 0 } },
+            { { 0, 1 }, { 1, 1 } },
+            { { 0, 2 }, { 1, 2 } },
+            { { 2, 4 }, { 3, 4 } },
+        };
+        VERIFY_IS_TRUE(results == expected.Results());
+        VERIFY_IS_TRUE(results == s.Results());
+    }
+
+    TEST_METHOD(RefineNeedle)
+    {
+        auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+
+        Search s;
+        s.Reset(gci.renderData, L"A", SearchFlag::None, false);
+
+        // Extending the needle only re-tests the lines that contained a previous result.
+        s.Reset(gci.renderData, L"AB", SearchFlag::None, false);
+
+        Search expected;
+        expected.Reset(gci.renderData, L"AB", SearchFlag::None, false);
+
+        VERIFY_ARE_EQUAL(4u, s.Results().size());
+        VERIFY_IS_TRUE(expected.Results() == s.Results());
+    }
 };
@@ -312,6 +312,7 @@ class TextBufferIteratorTests
 
     TEST_METHOD(ConstructedNoLimit);
     TEST_METHOD(ConstructedLimits);
+    TEST_METHOD(PlusEqualsAcrossRowsWithLimits);
 };
 
 void TextBufferIteratorTests::BoolOperatorText()
@@ -579,3 +580,29 @@ void TextBufferIteratorTests::ConstructedLimits()
                            wil::ResultException,
                            [](wil::ResultException& e) { return e.GetErrorCode() == E_INVALIDARG; });
 }
+
+void TextBufferIteratorTests::PlusEqualsAcrossRowsWithLimits()
+{
+    m_state->FillTextBuffer();
+
+    const auto& gci = ServiceLocator::LocateGlobals().getConsoleInformation();
+    const auto& textBuffer = gci.GetActiveOutputBuffer().GetTextBuffer();
+
+    // 3 columns wide, 2 rows high.
+    const auto viewport = Viewport::FromInclusive({ 3, 1, 5, 2 });
+
+    TextBufferCellIterator it(textBuffer, { 4, 1 }, viewport);
+
+    // Moving by the width of the bounds ends up in the same column on the next row.
+    it += 3;
+    VERIFY_IS_TRUE(it);
+    VERIFY_ARE_EQUAL(TextBufferCellIterator(textBuffer, { 4, 2 }, viewport), it);
+
+    // Moving to the last cell is still valid, but any further is not.
+    it += 1;
+    VERIFY_IS_TRUE(it);
+    VERIFY_ARE_EQUAL(TextBufferCellIterator(textBuffer, { 5, 2 }, viewport), it);
+
+    it += 2;
+    VERIFY_IS_FALSE(it);
+}
@@ -138,12 +138,22 @@ class TextBufferTests
     TEST_METHOD(TestOverwriteChars);
     TEST_METHOD(TestReplace);
     TEST_METHOD(TestInsert);
+    TEST_METHOD(TestCompact);
+    TEST_METHOD(TestResetRetainsOverflowBuffer);
+    TEST_METHOD(TestWriteRepeatedCharacters);
+    TEST_METHOD(TestMeasureEveryColumn);
+    TEST_METHOD(TestSearchTextChunked);
+    TEST_METHOD(TestGetDirtyRows);
+    TEST_METHOD(TestSerialize);
+    TEST_METHOD(TestGenHTMLAndRTFCoalesceRuns);
 
     TEST_METHOD(TestAppendRTFText);
 
     void WriteLinesToBuffer(const std::vector<std::wstring>& text, TextBuffer& buffer);
     TEST_METHOD(GetWordBoundaries);
     TEST_METHOD(MoveByWord);
+    TEST_METHOD(MoveByWordAcrossBlankRows);
+    TEST_METHOD(CopyRowSegmentWithWideGlyphs);
     TEST_METHOD(GetGlyphBoundaries);
 
     TEST_METHOD(GetTextRects);
@@ -1879,6 +1889,12 @@ void TextBufferTests::TestReplace()
             { L"", 4, 0, 5 },
             L" efg c" complex L"ab",
         },
+        Test{
+            L"ASCII after a wide glyph still joins with a following combining mark",
+            { complex L"ae\u0301f", 0, til::CoordTypeMax },
+            { L"", 5, 0, 5 },
+            complex L"ae\u0301fc" complex L"ab",
+        },
     };
 
     for (const auto& t : tests)
@@ -1981,6 +1997,325 @@ void TextBufferTests::TestInsert()
     VERIFY_ARE_EQUAL(expectedAttr, actualAttr);
 }
 
+void TextBufferTests::TestCompact()
+{
+    static constexpr til::size bufferSize{ 10, 3 };
+    static constexpr UINT cursorSize = 12;
+    static constexpr TextAttribute attr1{ 0x11111111, 0x00000000 };
+    static constexpr TextAttribute attr2{ 0x22222222, 0x00000000 };
+    TextBuffer buffer{ bufferSize, attr1, cursorSize, false, &_renderer };
+    auto& row = buffer.GetMutableRowByOffset(0);
+
+    // Combining marks push the text past the row width, which moves it onto the heap.
+    row.ReplaceCharacters(0, 1, L"a\u0301\u0302");
+    row.ReplaceCharacters(1, 1, L"b\u0301\u0302");
+    row.ReplaceAttributes(1, 2, attr2);
+    row.ReplaceAttributes(3, 4, attr2);
+
+    Log::Comment(L"Compacting a row whose text doesn't fit into the inline buffer preserves its contents");
+    auto expectedText = std::wstring{ row.GetText() };
+    auto expectedAttr = row.Attributes();
+    row.Compact();
+    VERIFY_ARE_EQUAL(expectedText, row.GetText());
+    VERIFY_ARE_EQUAL(expectedAttr, row.Attributes());
+
+    Log::Comment(L"Compacting a row that fits into the inline buffer again preserves its contents");
+    row.ReplaceCharacters(0, 1, L"c");
+    row.ReplaceCharacters(1, 1, L"d");
+    expectedText = std::wstring{ row.GetText() };
+    row.Compact();
+    VERIFY_ARE_EQUAL(expectedText, row.GetText());
+    VERIFY_ARE_EQUAL(expectedAttr, row.Attributes());
+
+    Log::Comment(L"A compacted row can be written to again");
+    row.ReplaceCharacters(2, 1, L"e\u0301");
+    VERIFY_ARE_EQUAL(L"cde\u0301       ", row.GetText());
+}
+
+void TextBufferTests::TestWriteRepeatedCharacters()
+{
+    static constexpr til::size bufferSize{ 10, 1 };
+    static constexpr UINT cursorSize = 12;
+    static constexpr TextAttribute attr{ 0x11111111, 0x00000000 };
+    TextBuffer buffer{ bufferSize, attr, cursorSize, false, &_renderer };
+    auto& row = buffer.GetMutableRowByOffset(0);
+
+    Log::Comment(L"A run of the same narrow character fills the row up to its limit");
+    {
+        RowWriteState state{ .text = L"\u2500\u2500\u2500\u2500\u2500\u2500\u2500\u2500\u2500\u2500\u2500\u2500" };
+        row.ReplaceText(state);
+        VERIFY_ARE_EQUAL(10, state.columnEnd);
+        VERIFY_ARE_EQUAL(L"\u2500\u2500", state.text);
+        VERIFY_ARE_EQUAL(L"\u2500\u2500\u2500\u2500\u2500\u2500\u2500\u2500\u2500\u2500", row.GetText());
+    }
+
+    Log::Comment(L"The last repetition still joins with a combining mark that follows it");
+    {
+        row.Reset(attr);
+        RowWriteState state{ .text = L"\u2500\u2500\u2500\u0301x" };
+        row.ReplaceText(state);
+        VERIFY_ARE_EQUAL(4, state.columnEnd);
+        VERIFY_ARE_EQUAL(L"\u2500\u0301", row.GlyphAt(2));
+        VERIFY_ARE_EQUAL(L"x", row.GlyphAt(3));
+    }
+}
+
+void TextBufferTests::TestResetRetainsOverflowBuffer()
+{
+    static constexpr til::size bufferSize{ 10, 3 };
+    static constexpr UINT cursorSize = 12;
+    static constexpr TextAttribute attr{ 0x11111111, 0x00000000 };
+    TextBuffer buffer{ bufferSize, attr, cursorSize, false, &_renderer };
+    auto& row = buffer.GetMutableRowByOffset(0);
+
+    row.ReplaceCharacters(0, 1, L"a\u0301\u0302");
+    row.ReplaceCharacters(1, 1, L"b\u0301\u0302");
+
+    Log::Comment(L"A reset row reads as blank even though it keeps its overflow buffer");
+    row.Reset(attr);
+    VERIFY_ARE_EQUAL(L"          ", row.GetText());
+
+    Log::Comment(L"Overflowing text written after a reset is stored correctly");
+    row.ReplaceCharacters(0, 1, L"c\u0301\u0302");
+    row.ReplaceCharacters(9, 1, L"d\u0301\u0302");
+    VERIFY_ARE_EQUAL(L"c\u0301\u0302        d\u0301\u0302", row.GetText());
+
+    Log::Comment(L"Compacting a reset row that doesn't overflow keeps its contents");
+    row.Reset(attr);
+    row.ReplaceCharacters(0, 1, L"e");
+    row.Compact();
+    VERIFY_ARE_EQUAL(L"e         ", row.GetText());
+}
+
+void TextBufferTests::TestMeasureEveryColumn()
+{
+    // 37 columns are enough to cover a couple full 8 character chunks as well as the scalar tail.
+    static constexpr til::size bufferSize{ 37, 1 };
+    static constexpr UINT cursorSize = 12;
+    TextBuffer buffer{ bufferSize, {}, cursorSize, false, &_renderer };
+    auto& row = buffer.GetMutableRowByOffset(0);
+
+    VERIFY_IS_FALSE(row.ContainsText());
+    VERIFY_ARE_EQUAL(bufferSize.width, row.MeasureLeft());
+    VERIFY_ARE_EQUAL(0, row.MeasureRight());
+
+    for (til::CoordType x = 0; x < bufferSize.width; ++x)
+    {
+        row.Reset({});
+        row.ReplaceCharacters(x, 1, L"a");
+        VERIFY_IS_TRUE(row.ContainsText());
+        VERIFY_ARE_EQUAL(x, row.MeasureLeft());
+        VERIFY_ARE_EQUAL(x + 1, row.MeasureRight());
+    }
+
+    Log::Comment(L"With text at both ends, the edges of the row are found");
+    row.Reset({});
+    row.ReplaceCharacters(0, 1, L"a");
+    row.ReplaceCharacters(bufferSize.width - 1, 1, L"b");
+    VERIFY_ARE_EQUAL(0, row.MeasureLeft());
+    VERIFY_ARE_EQUAL(bufferSize.width, row.MeasureRight());
+}
+
+void TextBufferTests::TestSearchTextChunked()
+{
+    // Large enough for SearchText() to split the buffer into chunks.
+    static constexpr til::size bufferSize{ 10, 40000 };
+    static constexpr UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    TextBuffer buffer{ bufferSize, attr, cursorSize, false, &_renderer };
+
+    // Every row contains a match and every 7th row wraps a match into the next row.
+    // Since chunk boundaries are placed at logical line boundaries, the wrapped
+    // matches must be found exactly as they are when searching all rows at once.
+    for (til::CoordType y = 0; y < bufferSize.height; ++y)
+    {
+        RowWriteState state{
+            .text = (y % 7) == 0 ? L"xxabxxxxab" : L"cdxabxxxxx",
+        };
+        buffer.Replace(y, attr, state);
+        buffer.GetMutableRowByOffset(y).SetWrapForced((y % 7) == 0);
+    }
+
+    for (const auto flags : { SearchFlag::None, SearchFlag::CaseInsensitive })
+    {
+        const auto expected = buffer.SearchText(L"abcd", flags, 0, til::CoordTypeMax);
+        const auto actual = buffer.SearchText(L"abcd", flags);
+        VERIFY_IS_TRUE(expected.has_value());
+        VERIFY_IS_TRUE(actual.has_value());
+        VERIFY_ARE_EQUAL(expected->size(), actual->size());
+        VERIFY_IS_TRUE(*expected == *actual);
+        VERIFY_ARE_EQUAL(gsl::narrow_cast<size_t>((bufferSize.height - 1 + 6) / 7), actual->size());
+    }
+}
+
+void TextBufferTests::TestGetDirtyRows()
+{
+    static constexpr til::size bufferSize{ 10, 5 };
+    static constexpr UINT cursorSize = 12;
+    const TextAttribute attr{ 0x7f };
+    TextBuffer buffer{ bufferSize, attr, cursorSize, false, &_renderer };
+
+    // This commits all rows of the buffer, because it's smaller than _commitReadAheadRowCount.
+    buffer.GetMutableRowByOffset(0).ReplaceCharacters(0, 1, L"a");
+
+    Log::Comment(L"Nothing changed");
+    auto cursor = buffer.GetRevisionCursor();
+    auto dirty = buffer.GetDirtyRows(cursor);
+    VERIFY_IS_TRUE(dirty.has_value());
+    VERIFY_ARE_EQUAL(0, dirty->scrolled);
+    VERIFY_ARE_EQUAL(bufferSize.height, dirty->begin);
+
+    Log::Comment(L"Modifying a row marks it as dirty");
+    buffer.GetMutableRowByOffset(3).ReplaceCharacters(0, 1, L"a");
+    dirty = buffer.GetDirtyRows(cursor);
+    VERIFY_IS_TRUE(dirty.has_value());
+    VERIFY_ARE_EQUAL(0, dirty->scrolled);
+    VERIFY_ARE_EQUAL(3, dirty->begin);
+
+    Log::Comment(L"Scrolling moves the dirty rows up and marks the new last row as dirty");
+    cursor = buffer.GetRevisionCursor();
+    buffer.IncrementCircularBuffer();
+    dirty = buffer.GetDirtyRows(cursor);
+    VERIFY_IS_TRUE(dirty.has_value());
+    VERIFY_ARE_EQUAL(1, dirty->scrolled);
+    VERIFY_ARE_EQUAL(bufferSize.height - 1, dirty->begin);
+
+    Log::Comment(L"Multiple cursors each see the rows modified since they were retrieved");
+    const auto cursorA = buffer.GetRevisionCursor();
+    buffer.GetMutableRowByOffset(4).ReplaceCharacters(0, 1, L"b");
+    const auto cursorB = buffer.GetRevisionCursor();
+    buffer.GetMutableRowByOffset(2).ReplaceCharacters(0, 1, L"b");
+    const auto cursorC = buffer.GetRevisionCursor();
+    buffer.GetMutableRowByOffset(3).ReplaceCharacters(0, 1, L"b");
+    VERIFY_ARE_EQUAL(2, buffer.GetDirtyRows(cursorA)->begin);
+    VERIFY_ARE_EQUAL(2, buffer.GetDirtyRows(cursorB)->begin);
+    VERIFY_ARE_EQUAL(3, buffer.GetDirtyRows(cursorC)->begin);
+
+    Log::Comment(L"Cursors older than all tracked watermarks still find the first modified row");
+    for (auto i = 0; i < 20; ++i)
+    {
+        buffer.GetMutableRowByOffset(4).ReplaceCharacters(0, 1, L"c");
+        buffer.GetRevisionCursor();
+    }
+    VERIFY_ARE_EQUAL(2, buffer.GetDirtyRows(cursorA)->begin);
+    VERIFY_ARE_EQUAL(bufferSize.height, buffer.GetDirtyRows(buffer.GetRevisionCursor())->begin);
+
+    Log::Comment(L"Cursors from before a row was moved otherwise are invalidated");
+    buffer.ResizeTraditional(bufferSize);
+    VERIFY_IS_FALSE(buffer.GetDirtyRows(cursor).has_value());
+    VERIFY_IS_TRUE(buffer.GetDirtyRows(buffer.GetRevisionCursor()).has_value());
+}
+
+void TextBufferTests::TestSerialize()
+{
+    static constexpr til::size bufferSize{ 12, 2 };
+    static constexpr UINT cursorSize = 12;
+    TextBuffer buffer{ bufferSize, {}, cursorSize, false, &_renderer };
+
+    const auto write = [&](til::CoordType column, std::wstring_view text, const TextAttribute& attr) {
+        RowWriteState state{
+            .text = text,
+            .columnBegin = column,
+        };
+        buffer.Replace(0, attr, state);
+    };
+
+    TextAttribute attr;
+    attr.SetIntense(true);
+    attr.SetFaint(true);
+    attr.SetForeground(TextColor{ 123, true });
+    attr.SetBackground(RGB(1, 2, 3));
+    attr.SetUnderlineColor(TextColor{ 200, true });
+    write(0, L"ab", attr);
+
+    // Turning off only faint requires SGR 22 followed by SGR 1.
+    attr.SetFaint(false);
+    attr.SetUnderlineStyle(UnderlineStyle::CurlyUnderlined);
+    attr.SetForeground(RGB(4, 5, 6));
+    attr.SetDefaultBackground();
+    attr.SetUnderlineColor(RGB(7, 8, 9));
+    write(2, L"cd", attr);
+
+    // The underline color must not be serialized as SGR 59 just because the foreground is the default.
+    attr.SetIntense(false);
+    attr.SetDefaultForeground();
+    attr.SetUnderlineColor(RGB(10, 11, 12));
+    write(4, L"ef", attr);
+
+    write(6, L"gh", {});
+
+    const auto path = std::filesystem::temp_directory_path() / L"TextBufferTests_TestSerialize.txt";
+    const auto cleanup = wil::scope_exit([&]() {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    });
+    buffer.Serialize(path.c_str());
+
+    std::wstring actual;
+    {
+        const wil::unique_handle file{ CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+        VERIFY_IS_TRUE(static_cast<bool>(file));
+
+        LARGE_INTEGER fileSize{};
+        VERIFY_WIN32_BOOL_SUCCEEDED(GetFileSizeEx(file.get(), &fileSize));
+        actual.resize(gsl::narrow<size_t>(fileSize.QuadPart) / sizeof(wchar_t));
+
+        DWORD bytesRead = 0;
+        VERIFY_WIN32_BOOL_SUCCEEDED(ReadFile(file.get(), actual.data(), gsl::narrow<DWORD>(fileSize.QuadPart), &bytesRead, nullptr));
+        VERIFY_ARE_EQUAL(fileSize.QuadPart, static_cast<LONGLONG>(bytesRead));
+    }
+
+    const std::wstring_view expected{
+        L"\uFEFF"
+        L"\x1b[1;2;38;5;123;48;2;1;2;3;58:5:200mab"
+        L"\x1b[22;1;4:3;38;2;4;5;6;49;58:2::7:8:9mcd"
+        L"\x1b[22;39;58:2::10:11:12mef"
+        L"\x1b[24;59mgh\x1b[K"
+        L"\x1b[m\r\n"
+    };
+    VERIFY_ARE_EQUAL(expected, std::wstring_view{ actual });
+}
+
+void TextBufferTests::TestGenHTMLAndRTFCoalesceRuns()
+{
+    static constexpr til::size bufferSize{ 10, 1 };
+    static constexpr UINT cursorSize = 12;
+    const TextAttribute attr1{ 0x7f };
+    auto attr2 = attr1;
+    attr2.SetHyperlinkId(1);
+    TextBuffer buffer{ bufferSize, attr1, cursorSize, false, &_renderer };
+
+    // Two runs with different attributes, but which look identical in HTML and RTF.
+    auto& row = buffer.GetMutableRowByOffset(0);
+    RowWriteState state{ .text = L"abcd" };
+    row.ReplaceText(state);
+    row.ReplaceAttributes(2, 4, attr2);
+    VERIFY_ARE_EQUAL(3u, row.Attributes().runs().size());
+
+    const auto getAttributeColors = [](const TextAttribute&) {
+        return std::tuple<COLORREF, COLORREF, COLORREF>{ RGB(255, 255, 255), RGB(0, 0, 0), RGB(255, 255, 255) };
+    };
+    const auto req = TextBuffer::CopyRequest{ buffer, { 0, 0 }, { 3, 0 }, false, true, true, false };
+
+    const auto countOf = [](const std::string_view& haystack, const std::string_view& needle) {
+        size_t count = 0;
+        for (auto pos = haystack.find(needle); pos != std::string_view::npos; pos = haystack.find(needle, pos + 1))
+        {
+            count++;
+        }
+        return count;
+    };
+
+    const auto html = buffer.GenHTML(req, 12, L"Consolas", RGB(0, 0, 0), false, getAttributeColors);
+    VERIFY_IS_TRUE(html.starts_with("Version:0.9\r\nStartHTML:0000000157\r\n"));
+    VERIFY_ARE_EQUAL(1u, countOf(html, "<SPAN"));
+    VERIFY_ARE_EQUAL(1u, countOf(html, ">abcd</SPAN>"));
+
+    const auto rtf = buffer.GenRTF(req, 12, L"Consolas", RGB(0, 0, 0), false, getAttributeColors);
+    VERIFY_ARE_EQUAL(1u, countOf(rtf, "\\cf"));
+    VERIFY_ARE_EQUAL(1u, countOf(rtf, " abcd}"));
+}
+
 void TextBufferTests::TestAppendRTFText()
 {
     {
@@ -2338,6 +2673,65 @@ void TextBufferTests::MoveByWord()
     }
 }
 
+void TextBufferTests::MoveByWordAcrossBlankRows()
+{
+    til::size bufferSize{ 80, 9001 };
+    UINT cursorSize = 12;
+    TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, false, &_renderer);
+
+    // The trailing whitespace of each row is skipped in one go. Make sure that
+    // this still stops at the right positions, including the row of the limit.
+    const std::vector<std::wstring> text = { L"zero one",
+                                             L"",
+                                             L"   ",
+                                             L"  two  three" };
+    WriteLinesToBuffer(text, *_buffer);
+
+    const std::wstring_view delimiters = L" ";
+    const auto lastCharPos = _buffer->GetLastNonSpaceCharacter();
+
+    auto pos = til::point{ 0, 0 };
+    VERIFY_IS_TRUE(_buffer->MoveToNextWord(pos, delimiters, lastCharPos));
+    VERIFY_ARE_EQUAL((til::point{ 5, 0 }), pos);
+    VERIFY_IS_TRUE(_buffer->MoveToNextWord(pos, delimiters, lastCharPos));
+    VERIFY_ARE_EQUAL((til::point{ 2, 3 }), pos);
+    VERIFY_IS_TRUE(_buffer->MoveToNextWord(pos, delimiters, lastCharPos));
+    VERIFY_ARE_EQUAL((til::point{ 7, 3 }), pos);
+    VERIFY_IS_FALSE(_buffer->MoveToNextWord(pos, delimiters, lastCharPos));
+
+    pos = { 2, 3 };
+    VERIFY_IS_TRUE(_buffer->MoveToPreviousWord(pos, delimiters));
+    VERIFY_ARE_EQUAL((til::point{ 5, 0 }), pos);
+
+    pos = { 50, 2 };
+    VERIFY_IS_TRUE(_buffer->MoveToPreviousWord(pos, delimiters));
+    VERIFY_ARE_EQUAL((til::point{ 0, 0 }), pos);
+
+    pos = { 79, 1 };
+    VERIFY_ARE_EQUAL((til::point{ 5, 0 }), _buffer->GetWordStart(pos, delimiters, true));
+}
+
+void TextBufferTests::CopyRowSegmentWithWideGlyphs()
+{
+    til::size bufferSize{ 10, 2 };
+    UINT cursorSize = 12;
+    TextAttribute attr{ 0x7f };
+    auto _buffer = std::make_unique<TextBuffer>(bufferSize, attr, cursorSize, false, &_renderer);
+
+    const std::vector<std::wstring> text = { L"aこbにc",
+                                             L"xxxxxxxxxx" };
+    WriteLinesToBuffer(text, *_buffer);
+
+    Log::Comment(L"A segment starting on a trailing half gets a whitespace in its place.");
+    _buffer->CopyRowSegment(0, 2, 1, 1, 4);
+    VERIFY_ARE_EQUAL(L"x bにxxxxx", _buffer->GetRowByOffset(1).GetText());
+
+    Log::Comment(L"Shifting a segment within the same row must not destroy its wide glyphs.");
+    _buffer->CopyRowSegment(0, 0, 0, 1, 6);
+    VERIFY_ARE_EQUAL(L"aaこbに   ", _buffer->GetRowByOffset(0).GetText());
+}
+
 void TextBufferTests::GetGlyphBoundaries()
 {
     struct ExpectedResult
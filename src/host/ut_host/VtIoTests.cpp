@@ -275,6 +275,36 @@ class ::Microsoft::Console::VirtualTerminal::VtIoTests
         VERIFY_ARE_EQUAL(expected, actual);
     }
 
+    TEST_METHOD(WriteConsoleOutputWUnchanged)
+    {
+        resetContents();
+
+        std::array payload{ ci_red('A'), ci_red('B'), ci_blu('a'), ci_blu('b'), ci_red('C'), ci_red('D'), ci_blu('c'), ci_blu('d') };
+        const auto target = Viewport::FromDimensions({ 0, 0 }, { 8, 1 });
+        Viewport written;
+        THROW_IF_FAILED(routines.WriteConsoleOutputWImpl(*screenInfo, payload, target, written));
+
+        std::string_view expected = decsc() cup(1, 1) sgr_red("AB") sgr_blu("ab") sgr_red("CD") sgr_blu("cd") decrc();
+        auto actual = readOutput();
+        VERIFY_ARE_EQUAL(expected, actual);
+
+        // Writing the same contents again emits nothing at all (not even DECSC/DECRC).
+        THROW_IF_FAILED(routines.WriteConsoleOutputWImpl(*screenInfo, payload, target, written));
+
+        expected = "";
+        actual = readOutput();
+        VERIFY_ARE_EQUAL(expected, actual);
+
+        // Only the cells that changed are written. Short gaps of unchanged cells are written as well.
+        payload[1] = ci_blu('x');
+        payload[3] = ci_red('y');
+        THROW_IF_FAILED(routines.WriteConsoleOutputWImpl(*screenInfo, payload, target, written));
+
+        expected = decsc() cup(1, 2) sgr_blu("xa") sgr_red("y") decrc();
+        actual = readOutput();
+        VERIFY_ARE_EQUAL(expected, actual);
+    }
+
     TEST_METHOD(WriteConsoleOutputAttribute)
     {
         setupInitialContents();
@@ -815,4 +845,39 @@ class ::Microsoft::Console::VirtualTerminal::VtIoTests
         const auto actual = readOutput();
         VERIFY_ARE_EQUAL(expected, actual);
     }
+
+    TEST_METHOD(SetConsoleActiveScreenBufferErasesTrailingBlanks)
+    {
+        SCREEN_INFORMATION* screenInfoAlt;
+
+        VERIFY_NT_SUCCESS(SCREEN_INFORMATION::CreateInstance(
+            screenInfo->GetViewport().Dimensions(),
+            screenInfo->GetCurrentFont(),
+            screenInfo->GetBufferSize().Dimensions(),
+            screenInfo->GetAttributes(),
+            screenInfo->GetPopupAttributes(),
+            screenInfo->GetTextBuffer().GetCursor().GetSize(),
+            &screenInfoAlt));
+
+        routines.SetConsoleActiveScreenBufferImpl(*screenInfoAlt);
+        setupInitialContents();
+        // Erase the second half of the 2nd row and all of the 3rd row with a blue background.
+        screenInfo->GetStateMachine().ProcessString(L"\x1b[2;5H" sgr_blu("\x1b[K") "\x1b[3;1H\x1b[K\x1b[H" sgr_rst());
+        THROW_IF_FAILED(routines.SetConsoleOutputModeImpl(*screenInfoAlt, ENABLE_PROCESSED_OUTPUT | ENABLE_WRAP_AT_EOL_OUTPUT | ENABLE_VIRTUAL_TERMINAL_PROCESSING));
+        readOutput();
+
+        routines.SetConsoleActiveScreenBufferImpl(*screenInfo);
+
+        const auto expected =
+            "\x1b[?1049l" // ASB (Alternate Screen Buffer)
+            cup(1, 1) sgr_red("AB") sgr_blu("ab") sgr_red("CD") sgr_blu("cd") //
+            cup(2, 1) sgr_red("EF") sgr_blu("ef") "\x1b[K" //
+            cup(3, 1) sgr_blu("\x1b[K") //
+            cup(4, 1) sgr_blu("mn") sgr_red("MN") sgr_blu("op") sgr_red("OP") //
+            cup(1, 1) sgr_rst() //
+            "\x1b[?25h" // DECTCEM (Text Cursor Enable)
+            "\x1b[?7h"; // DECAWM (Autowrap Mode)
+        const auto actual = readOutput();
+        VERIFY_ARE_EQUAL(expected, actual);
+    }
 };
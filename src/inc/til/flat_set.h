@@ -149,6 +149,38 @@ namespace til
             }
         }
 
+        // Removes the given slot, which must have been returned by lookup() or insert().
+        // Instead of leaving a tombstone behind, the following entries in the probe sequence
+        // are shifted back into the hole if that gets them closer to their ideal position.
+        // This keeps lookups exactly as fast as if the item had never been inserted.
+        void erase(T* slot) noexcept
+        {
+            auto hole = gsl::narrow_cast<size_t>(slot - _map.get());
+
+            for (auto i = hole;;)
+            {
+                i = (i + 1) & _mask;
+
+                auto& next = _map[i];
+                if (!Traits::occupied(next))
+                {
+                    break;
+                }
+
+                // If the ideal position of `next` is not within (hole, i], then moving it to `hole`
+                // still keeps it reachable. Otherwise, it must stay where it is.
+                const auto ideal = Traits::hash(next) >> _shift;
+                if (((i - ideal) & _mask) >= ((i - hole) & _mask))
+                {
+                    _map[hole] = std::move(next);
+                    hole = i;
+                }
+            }
+
+            _map[hole] = T{};
+            _load -= LoadFactor;
+        }
+
     private:
         __declspec(noinline) void _bumpSize()
         {
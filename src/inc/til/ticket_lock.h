@@ -7,6 +7,19 @@
 
 namespace til
 {
+#if defined(TIL_TICKET_LOCK_STATS)
+    // Contention counters collected by ticket_lock if TIL_TICKET_LOCK_STATS is defined.
+    // The *_ticks members are in QueryPerformanceCounter() units.
+    struct ticket_lock_stats
+    {
+        uint64_t acquisitions = 0;
+        uint64_t contended = 0;
+        uint64_t wait_ticks = 0;
+        uint64_t max_wait_ticks = 0;
+        uint64_t hold_ticks = 0;
+    };
+#endif
+
     // ticket_lock implements a classic fair lock.
     //
     // Compared to a SRWLOCK this implementation is significantly more unsafe to use:
@@ -23,6 +36,11 @@ namespace til
         {
             const auto ticket = _next_ticket.fetch_add(1, std::memory_order_relaxed);
 
+#if defined(TIL_TICKET_LOCK_STATS)
+            const auto waitBeg = _stats_now();
+            bool contended = false;
+#endif
+
             for (;;)
             {
                 const auto current = _now_serving.load(std::memory_order_acquire);
@@ -31,16 +49,54 @@ namespace til
                     break;
                 }
 
+#if defined(TIL_TICKET_LOCK_STATS)
+                contended = true;
+#endif
                 til::atomic_wait(_now_serving, current);
             }
+
+#if defined(TIL_TICKET_LOCK_STATS)
+            // We're holding the lock now, so the counters can be updated without atomics.
+            _hold_beg = _stats_now();
+            _stats.acquisitions++;
+            if (contended)
+            {
+                const auto wait = _hold_beg - waitBeg;
+                _stats.contended++;
+                _stats.wait_ticks += wait;
+                _stats.max_wait_ticks = std::max(_stats.max_wait_ticks, wait);
+            }
+#endif
         }
 
         void unlock() noexcept
         {
+#if defined(TIL_TICKET_LOCK_STATS)
+            _stats.hold_ticks += _stats_now() - _hold_beg;
+#endif
             _now_serving.fetch_add(1, std::memory_order_release);
             til::atomic_notify_all(_now_serving);
         }
 
+#if defined(TIL_TICKET_LOCK_STATS)
+        // Returns a snapshot of the counters. Call it while holding the lock to get consistent values.
+        ticket_lock_stats stats() const noexcept
+        {
+            return _stats;
+        }
+
+    private:
+        static uint64_t _stats_now() noexcept
+        {
+            LARGE_INTEGER now;
+            QueryPerformanceCounter(&now);
+            return static_cast<uint64_t>(now.QuadPart);
+        }
+
+        ticket_lock_stats _stats;
+        uint64_t _hold_beg = 0;
+#endif
+
     private:
         // You may be inclined to add alignas(std::hardware_destructive_interference_size)
         // here to force the two atomics on separate cache lines, but I suggest to carefully
@@ -146,6 +202,14 @@ namespace til
             return is_locked() ? _recursion : 0;
         }
 
+#if defined(TIL_TICKET_LOCK_STATS)
+        // Recursive acquisitions aren't counted, since they never wait.
+        ticket_lock_stats stats() const noexcept
+        {
+            return _lock.stats();
+        }
+#endif
+
     private:
         ticket_lock _lock;
         std::atomic<uint32_t> _owner = 0;
@@ -14,6 +14,11 @@ could overcome disadvantages of syscalls. Test results can be read up
 in PR #4093 and the test algorithms are available in src\tools\U8U16Test.
 Based on the results the decision was made to keep using the platform
 functions MultiByteToWideChar and WideCharToMultiByte.
+Since then, an ASCII fast lane was added in front of them, because
+most of the console's output is ASCII and widening/narrowing it
+is trivial and far cheaper than a call into the platform functions.
+Short ASCII gaps in non-ASCII text are left to the platform functions,
+so that mixed text doesn't result in one call per word.
 
 Author(s):
 - Steffen Illhardt (german-one), Leonard Hecker (lhecker) 2020-2021
@@ -23,6 +28,160 @@ Author(s):
 
 namespace til // Terminal Implementation Library. Also: "Today I Learned"
 {
+    namespace details
+    {
+        // ASCII runs shorter than this are passed to the platform functions together with the surrounding
+        // non-ASCII text. Otherwise a mix of ASCII and, for instance, CJK or Cyrillic would result in one
+        // platform call per word, because of all the spaces and punctuation in between.
+        inline constexpr int min_ascii_run = 16;
+
+#pragma warning(push)
+#pragma warning(disable : 26429 26481 26490) // use not_null, pointer arithmetic, reinterpret_cast
+        // Widens the leading ASCII characters in src to dst and returns their count.
+        inline size_t widen_ascii(const char* src, wchar_t* dst, const size_t len) noexcept
+        {
+            size_t i = 0;
+#if defined(TIL_SSE_INTRINSICS)
+            for (; i + 16 <= len; i += 16)
+            {
+                const auto vec = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                if (_mm_movemask_epi8(vec))
+                {
+                    break;
+                }
+                const auto zero = _mm_setzero_si128();
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_unpacklo_epi8(vec, zero));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i + 8), _mm_unpackhi_epi8(vec, zero));
+            }
+#endif
+            for (; i < len && static_cast<uint8_t>(src[i]) < 0x80; ++i)
+            {
+                dst[i] = static_cast<wchar_t>(src[i]);
+            }
+            return i;
+        }
+
+        // Narrows the leading ASCII characters in src to dst and returns their count.
+        inline size_t narrow_ascii(const wchar_t* src, char* dst, const size_t len) noexcept
+        {
+            size_t i = 0;
+#if defined(TIL_SSE_INTRINSICS)
+            for (; i + 16 <= len; i += 16)
+            {
+                const auto lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                const auto hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8));
+                const auto nonAscii = _mm_and_si128(_mm_or_si128(lo, hi), _mm_set1_epi16(static_cast<short>(0xff80)));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi8(nonAscii, _mm_setzero_si128())) != 0xffff)
+                {
+                    break;
+                }
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(lo, hi));
+            }
+#endif
+            for (; i < len && src[i] < 0x80; ++i)
+            {
+                dst[i] = static_cast<char>(src[i]);
+            }
+            return i;
+        }
+
+        // Like MultiByteToWideChar(CP_UTF8, 0, ...), but with ASCII runs widened directly.
+        // ASCII characters are always code point boundaries, which allows us to pass only the
+        // non-ASCII parts of the string (including short ASCII gaps, see min_ascii_run)
+        // to MultiByteToWideChar without changing the result.
+        // The caller must ensure that capa16 >= len8. Returns 0 on failure.
+        inline int utf8_to_utf16(const char* in8, const int len8, wchar_t* out16, const int capa16) noexcept
+        {
+            int pos8 = 0;
+            int pos16 = 0;
+
+            while (pos8 < len8)
+            {
+                const auto ascii = gsl::narrow_cast<int>(widen_ascii(in8 + pos8, out16 + pos16, gsl::narrow_cast<size_t>(len8 - pos8)));
+                pos8 += ascii;
+                pos16 += ascii;
+
+                if (pos8 >= len8)
+                {
+                    break;
+                }
+
+                auto end8 = pos8 + 1;
+                for (auto asciiRun = 0; end8 < len8; ++end8)
+                {
+                    if (static_cast<uint8_t>(in8[end8]) >= 0x80)
+                    {
+                        asciiRun = 0;
+                    }
+                    else if (++asciiRun >= min_ascii_run)
+                    {
+                        end8 -= asciiRun - 1;
+                        break;
+                    }
+                }
+
+                const auto written = MultiByteToWideChar(CP_UTF8, 0UL, in8 + pos8, end8 - pos8, out16 + pos16, capa16 - pos16);
+                if (!written)
+                {
+                    return 0;
+                }
+
+                pos8 = end8;
+                pos16 += written;
+            }
+
+            return pos16;
+        }
+
+        // Like WideCharToMultiByte(CP_UTF8, 0, ...), but with ASCII runs narrowed directly.
+        // Just like in utf8_to_utf16(), short ASCII gaps are passed to WideCharToMultiByte as well.
+        // Surrogate pairs consist of two non-ASCII code units and are thus never split up.
+        // The caller must ensure that capa8 >= len16 * 3. Returns 0 on failure.
+        inline int utf16_to_utf8(const wchar_t* in16, const int len16, char* out8, const int capa8) noexcept
+        {
+            int pos16 = 0;
+            int pos8 = 0;
+
+            while (pos16 < len16)
+            {
+                const auto ascii = gsl::narrow_cast<int>(narrow_ascii(in16 + pos16, out8 + pos8, gsl::narrow_cast<size_t>(len16 - pos16)));
+                pos16 += ascii;
+                pos8 += ascii;
+
+                if (pos16 >= len16)
+                {
+                    break;
+                }
+
+                auto end16 = pos16 + 1;
+                for (auto asciiRun = 0; end16 < len16; ++end16)
+                {
+                    if (in16[end16] >= 0x80)
+                    {
+                        asciiRun = 0;
+                    }
+                    else if (++asciiRun >= min_ascii_run)
+                    {
+                        end16 -= asciiRun - 1;
+                        break;
+                    }
+                }
+
+                const auto written = WideCharToMultiByte(CP_UTF8, 0UL, in16 + pos16, end16 - pos16, out8 + pos8, capa8 - pos8, nullptr, nullptr);
+                if (!written)
+                {
+                    return 0;
+                }
+
+                pos16 = end16;
+                pos8 += written;
+            }
+
+            return pos8;
+        }
+#pragma warning(pop)
+    }
+
     // state structure for maintenance of UTF-8 partials
     struct u8state
     {
@@ -70,7 +229,7 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             // The worst ratio of UTF-8 code units to UTF-16 code units is 1 to 1 if UTF-8 consists of ASCII only.
             RETURN_HR_IF(E_ABORT, !base::MakeCheckedNum(in.length()).AssignIfValid(&lengthRequired));
             out.resize(in.length()); // avoid to call MultiByteToWideChar twice only to get the required size
-            const int lengthOut = MultiByteToWideChar(CP_UTF8, 0ul, in.data(), lengthRequired, out.data(), lengthRequired);
+            const int lengthOut = details::utf8_to_utf16(in.data(), lengthRequired, out.data(), lengthRequired);
             out.resize(gsl::narrow_cast<size_t>(lengthOut));
 
             return lengthOut == 0 ? E_UNEXPECTED : S_OK;
@@ -158,7 +317,7 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
 
             if (len8)
             {
-                const auto convLen{ MultiByteToWideChar(CP_UTF8, 0UL, cursor8, len8, out.data() + len16, capa16) };
+                const auto convLen{ details::utf8_to_utf16(cursor8, len8, out.data() + len16, capa16) };
                 RETURN_HR_IF(E_UNEXPECTED, !convLen);
 
                 len16 += convLen;
@@ -197,7 +356,7 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
             // Thus, the worst ratio of UTF-16 code units to UTF-8 code units is 1 to 3.
             RETURN_HR_IF(E_ABORT, !base::MakeCheckedNum(in.length()).AssignIfValid(&lengthIn) || !base::CheckMul(lengthIn, 3).AssignIfValid(&lengthRequired));
             out.resize(gsl::narrow_cast<size_t>(lengthRequired)); // avoid to call WideCharToMultiByte twice only to get the required size
-            const int lengthOut = WideCharToMultiByte(CP_UTF8, 0ul, in.data(), lengthIn, out.data(), lengthRequired, nullptr, nullptr);
+            const int lengthOut = details::utf16_to_utf8(in.data(), lengthIn, out.data(), lengthRequired);
             out.resize(gsl::narrow_cast<size_t>(lengthOut));
 
             return lengthOut == 0 ? E_UNEXPECTED : S_OK;
@@ -259,7 +418,7 @@ namespace til // Terminal Implementation Library. Also: "Today I Learned"
 
             if (len16)
             {
-                const auto convLen{ WideCharToMultiByte(CP_UTF8, 0UL, cursor16, len16, out.data() + len8, capa8, nullptr, nullptr) };
+                const auto convLen{ details::utf16_to_utf8(cursor16, len16, out.data() + len8, capa8) };
                 RETURN_HR_IF(E_UNEXPECTED, !convLen);
 
                 len8 += convLen;
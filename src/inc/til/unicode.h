@@ -25,6 +25,20 @@ namespace til
         return (wch & 0xFC00) == 0xDC00;
     }
 
+    // Returns true for the bulk of CJK text: Kana, CJK ideographs, Hangul syllables and fullwidth forms.
+    // Each of these always forms a wide grapheme cluster of its own, as long as it isn't followed by something like
+    // a combining mark. This also means that its font fallback doesn't depend on the surrounding text.
+    constexpr bool is_standalone_wide(const wchar_t ch) noexcept
+    {
+        return (ch >= 0x3041 && ch <= 0x3096) || // Hiragana
+               (ch >= 0x30A1 && ch <= 0x30FA) || // Katakana
+               (ch >= 0x3400 && ch <= 0x4DBF) || // CJK Unified Ideographs Extension A
+               (ch >= 0x4E00 && ch <= 0x9FFF) || // CJK Unified Ideographs
+               (ch >= 0xAC00 && ch <= 0xD7A3) || // Hangul Syllables
+               (ch >= 0xF900 && ch <= 0xFAFF) || // CJK Compatibility Ideographs
+               (ch >= 0xFF01 && ch <= 0xFF60); // Fullwidth Forms
+    }
+
     constexpr char32_t combine_surrogates(const auto lead, const auto trail)
     {
         // Ah, I love these bracketed C-style casts. I use them in C all the time. Yep.
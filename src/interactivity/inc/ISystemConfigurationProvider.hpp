@@ -31,6 +31,7 @@ namespace Microsoft::Console::Interactivity
         virtual ~ISystemConfigurationProvider() = default;
 
         virtual bool IsCaretBlinkingEnabled() = 0;
+        virtual bool IsRemoteSession() = 0;
 
         virtual UINT GetCaretBlinkTime() = 0;
         virtual int GetNumberOfMouseButtons() = 0;
@@ -17,6 +17,18 @@ bool SystemConfigurationProvider::IsCaretBlinkingEnabled() noexcept
     return s_DefaultIsCaretBlinkingEnabled;
 }
 
+bool SystemConfigurationProvider::IsRemoteSession() noexcept
+{
+    if (IsGetSystemMetricsPresent())
+    {
+        return GetSystemMetrics(SM_REMOTESESSION) != 0;
+    }
+    else
+    {
+        return s_DefaultIsRemoteSession;
+    }
+}
+
 int SystemConfigurationProvider::GetNumberOfMouseButtons() noexcept
 {
     if (IsGetSystemMetricsPresent())
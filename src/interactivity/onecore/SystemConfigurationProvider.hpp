@@ -26,6 +26,7 @@ namespace Microsoft::Console::Interactivity::OneCore
     {
     public:
         bool IsCaretBlinkingEnabled() noexcept override;
+        bool IsRemoteSession() noexcept override;
 
         UINT GetCaretBlinkTime() noexcept override;
         int GetNumberOfMouseButtons() noexcept override;
@@ -43,6 +44,7 @@ namespace Microsoft::Console::Interactivity::OneCore
     private:
         static constexpr UINT s_DefaultCaretBlinkTime = 530; // milliseconds
         static constexpr bool s_DefaultIsCaretBlinkingEnabled = true;
+        static constexpr bool s_DefaultIsRemoteSession = false;
         static constexpr int s_DefaultNumberOfMouseButtons = 3;
         static constexpr ULONG s_DefaultCursorWidth = 1;
         static constexpr ULONG s_DefaultNumberOfWheelScrollLines = 3;
@@ -26,6 +26,7 @@ namespace Microsoft::Console::Interactivity::Win32
         ~SystemConfigurationProvider() = default;
 
         bool IsCaretBlinkingEnabled();
+        bool IsRemoteSession();
 
         UINT GetCaretBlinkTime();
         int GetNumberOfMouseButtons();
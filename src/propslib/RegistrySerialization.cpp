@@ -90,15 +90,94 @@ const size_t RegistrySerialization::s_GlobalPropMappingsSize = ARRAYSIZE(s_Globa
 
 // clang-format on
 
+// Routine Description:
+// - Reads all values of the given key into memory.
+// Arguments:
+// - hKey - Registry key to read from
+RegistrySerialization::ValueSnapshot::ValueSnapshot(const HKEY hKey) noexcept
+try
+{
+    DWORD cValues = 0;
+    DWORD cchMaxValueName = 0;
+    DWORD cbMaxValueData = 0;
+    if (RegQueryInfoKeyW(hKey, nullptr, nullptr, nullptr, nullptr, nullptr, nullptr, &cValues, &cchMaxValueName, &cbMaxValueData, nullptr, nullptr) != ERROR_SUCCESS)
+    {
+        return;
+    }
+
+    std::wstring name(cchMaxValueName + 1, L'\0');
+    std::vector<BYTE> data(std::max<DWORD>(cbMaxValueData, 1));
+    _values.reserve(cValues);
+
+    for (DWORD dwIndex = 0;;)
+    {
+        auto cchName = gsl::narrow_cast<DWORD>(name.size());
+        auto cbData = gsl::narrow_cast<DWORD>(data.size());
+        DWORD type = REG_NONE;
+        const auto result = RegEnumValueW(hKey, dwIndex, name.data(), &cchName, nullptr, &type, data.data(), &cbData);
+
+        // A value was added or grew since we called RegQueryInfoKeyW. Grow the buffers and retry.
+        if (result == ERROR_MORE_DATA)
+        {
+            name.resize(name.size() * 2);
+            data.resize(std::max<size_t>(cbData, data.size() * 2));
+            continue;
+        }
+        if (result != ERROR_SUCCESS)
+        {
+            break;
+        }
+
+        _values.emplace_back(Value{ { name.data(), cchName }, type, { data.begin(), data.begin() + cbData } });
+        dwIndex++;
+    }
+}
+CATCH_LOG()
+
+// Routine Description:
+// - Retrieves the data of a value from the snapshot. Behaves exactly like s_QueryValue.
+[[nodiscard]] NTSTATUS RegistrySerialization::ValueSnapshot::QueryValue(_In_ PCWSTR const pwszValueName,
+                                                                        const DWORD cbValueLength,
+                                                                        const DWORD regType,
+                                                                        _Out_writes_bytes_(cbValueLength) BYTE* const pbData,
+                                                                        _Out_opt_ _Out_range_(0, cbValueLength) DWORD* const pcbDataLength) const noexcept
+{
+    // Registry value names are case-insensitive.
+    const auto it = std::find_if(_values.begin(), _values.end(), [&](const Value& v) {
+        return _wcsicmp(v.name.c_str(), pwszValueName) == 0;
+    });
+    if (it == _values.end())
+    {
+        return NTSTATUS_FROM_WIN32(ERROR_FILE_NOT_FOUND);
+    }
+    if (it->type != regType)
+    {
+        return STATUS_OBJECT_TYPE_MISMATCH;
+    }
+
+    const auto cbData = gsl::narrow_cast<DWORD>(it->data.size());
+    if (nullptr != pcbDataLength)
+    {
+        *pcbDataLength = cbData;
+    }
+    if (cbData > cbValueLength)
+    {
+        return NTSTATUS_FROM_WIN32(ERROR_MORE_DATA);
+    }
+
+    memcpy(pbData, it->data.data(), cbData);
+    return STATUS_SUCCESS;
+}
+
 // Routine Description:
 // - Reads number from the registry and applies it to the given property if the value exists
 //   Supports: Dword, Word, Byte, Boolean, and Coordinate
 // Arguments:
-// - hKey - Registry key to read from
+// - values - Registry key contents to read from
 // - pPropMap - Contains property information to use in looking up/storing value data
 // Return Value:
 // - STATUS_SUCCESSFUL or appropriate NTSTATUS reply for registry operations.
-[[nodiscard]] NTSTATUS RegistrySerialization::s_LoadRegDword(const HKEY hKey, const _RegPropertyMap* const pPropMap, _In_ Settings* const pSettings)
+[[nodiscard]] NTSTATUS RegistrySerialization::s_LoadRegDword(const ValueSnapshot& values, const _RegPropertyMap* const pPropMap, _In_ Settings* const pSettings)
 {
     // find offset into destination structure for this numerical value
     const auto pbField = (PBYTE)pSettings + pPropMap->dwFieldOffset;
@@ -106,12 +185,11 @@ const size_t RegistrySerialization::s_GlobalPropMappingsSize = ARRAYSIZE(s_Globa
     // attempt to load number into this field
     // If we're not successful, it's ok. Just don't fill it.
     DWORD dwValue;
-    auto Status = s_QueryValue(hKey,
-                               pPropMap->pwszValueName,
-                               sizeof(dwValue),
-                               ToWin32RegistryType(pPropMap->propertyType),
-                               (PBYTE)&dwValue,
-                               nullptr);
+    auto Status = values.QueryValue(pPropMap->pwszValueName,
+                                    sizeof(dwValue),
+                                    ToWin32RegistryType(pPropMap->propertyType),
+                                    (PBYTE)&dwValue,
+                                    nullptr);
     if (SUCCEEDED_NTSTATUS(Status))
     {
         switch (pPropMap->propertyType)
@@ -154,11 +232,11 @@ const size_t RegistrySerialization::s_GlobalPropMappingsSize = ARRAYSIZE(s_Globa
 // Routine Description:
 // - Reads string from the registry and applies it to the given property if the value exists
 // Arguments:
-// - hKey - Registry key to read from
+// - values - Registry key contents to read from
 // - pPropMap - Contains property information to use in looking up/storing value data
 // Return Value:
 // - STATUS_SUCCESSFUL or appropriate NTSTATUS reply for registry operations.
-[[nodiscard]] NTSTATUS RegistrySerialization::s_LoadRegString(const HKEY hKey, const _RegPropertyMap* const pPropMap, _In_ Settings* const pSettings)
+[[nodiscard]] NTSTATUS RegistrySerialization::s_LoadRegString(const ValueSnapshot& values, const _RegPropertyMap* const pPropMap, _In_ Settings* const pSettings)
 {
     // find offset into destination structure for this numerical value
     const auto pbField = (PBYTE)pSettings + pPropMap->dwFieldOffset;
@@ -170,12 +248,11 @@ const size_t RegistrySerialization::s_GlobalPropMappingsSize = ARRAYSIZE(s_Globa
     auto Status = NT_TESTNULL(pwchString);
     if (SUCCEEDED_NTSTATUS(Status))
     {
-        Status = s_QueryValue(hKey,
-                              pPropMap->pwszValueName,
-                              (DWORD)(cchField) * sizeof(WCHAR),
-                              ToWin32RegistryType(pPropMap->propertyType),
-                              (PBYTE)pwchString,
-                              nullptr);
+        Status = values.QueryValue(pPropMap->pwszValueName,
+                                   (DWORD)(cchField) * sizeof(WCHAR),
+                                   ToWin32RegistryType(pPropMap->propertyType),
+                                   (PBYTE)pwchString,
+                                   nullptr);
         if (SUCCEEDED_NTSTATUS(Status))
         {
             // ensure pwchString is null terminated
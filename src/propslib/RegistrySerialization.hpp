@@ -78,6 +78,32 @@ public:
 
     static DWORD ToWin32RegistryType(const _RegPropertyType type);
 
+    // A copy of all values stored directly under a registry key, read with a single RegEnumValueW pass.
+    // Loading the console settings queries ~50 values, most of which don't exist in a title subkey,
+    // and on machines with roaming profiles every one of those RegQueryValueExW calls is costly.
+    class ValueSnapshot
+    {
+    public:
+        explicit ValueSnapshot(const HKEY hKey) noexcept;
+
+        // Same contract as s_QueryValue.
+        [[nodiscard]] NTSTATUS QueryValue(_In_ PCWSTR const pwszValueName,
+                                          const DWORD cbValueLength,
+                                          const DWORD regType,
+                                          _Out_writes_bytes_(cbValueLength) BYTE* const pbData,
+                                          _Out_opt_ _Out_range_(0, cbValueLength) DWORD* const pcbDataLength) const noexcept;
+
+    private:
+        struct Value
+        {
+            std::wstring name;
+            DWORD type;
+            std::vector<BYTE> data;
+        };
+
+        std::vector<Value> _values;
+    };
+
     typedef struct _RegPropertyMap
     {
         _RegPropertyType propertyType;
@@ -92,6 +118,6 @@ public:
     static const RegPropertyMap s_GlobalPropMappings[];
     static const size_t s_GlobalPropMappingsSize;
 
-    [[nodiscard]] static NTSTATUS s_LoadRegDword(const HKEY hKey, const _RegPropertyMap* const pPropMap, _In_ Settings* const pSettings);
-    [[nodiscard]] static NTSTATUS s_LoadRegString(const HKEY hKey, const _RegPropertyMap* const pPropMap, _In_ Settings* const pSettings);
+    [[nodiscard]] static NTSTATUS s_LoadRegDword(const ValueSnapshot& values, const _RegPropertyMap* const pPropMap, _In_ Settings* const pSettings);
+    [[nodiscard]] static NTSTATUS s_LoadRegString(const ValueSnapshot& values, const _RegPropertyMap* const pPropMap, _In_ Settings* const pSettings);
 };
@@ -179,10 +179,23 @@ void AtlasEngine::_invalidateSpans(std::span<const til::point_span> spans, const
 
 [[nodiscard]] HRESULT AtlasEngine::UpdateSoftFont(const std::span<const uint16_t> bitPattern, const til::size cellSize, const size_t centeringHint) noexcept
 {
+    const auto width = std::max(0, cellSize.width);
+    const auto height = std::max(0, cellSize.height);
+    const auto& current = *_api.s->font;
+
+    // Applications tend to re-upload the same soft font on every launch. Writing to the font
+    // settings bumps their generation, which flushes the entire glyph atlas, so avoid that
+    // if nothing actually changed.
+    if (current.softFontCellSize.width == width && current.softFontCellSize.height == height &&
+        std::equal(current.softFontPattern.begin(), current.softFontPattern.end(), bitPattern.begin(), bitPattern.end()))
+    {
+        return S_OK;
+    }
+
     const auto softFont = _api.s.write()->font.write();
     softFont->softFontPattern.assign(bitPattern.begin(), bitPattern.end());
-    softFont->softFontCellSize.width = std::max(0, cellSize.width);
-    softFont->softFontCellSize.height = std::max(0, cellSize.height);
+    softFont->softFontCellSize.width = width;
+    softFont->softFontCellSize.height = height;
     return S_OK;
 }
 
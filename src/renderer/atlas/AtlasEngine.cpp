@@ -76,6 +76,9 @@ try
         _handleSettingsUpdate();
     }
 
+    // The render settings (color table, blink state, etc.) may have changed between frames.
+    _api.drawingBrushesAttributes.reset();
+
     if constexpr (ATLAS_DEBUG_DISABLE_PARTIAL_INVALIDATION)
     {
         _api.invalidatedRows = invalidatedRowsAll;
@@ -644,6 +647,13 @@ CATCH_RETURN()
 [[nodiscard]] HRESULT AtlasEngine::UpdateDrawingBrushes(const TextAttribute& textAttributes, const RenderSettings& renderSettings, const gsl::not_null<IRenderData*> /*pData*/, const bool usingSoftFont, const bool isSettingDefaultBrushes) noexcept
 try
 {
+    // Consecutive runs frequently share the same attributes, for instance when the pattern IDs change or
+    // when each row starts with the default attributes. Resolving the colors isn't cheap, so we skip it then.
+    if (!isSettingDefaultBrushes && _api.drawingBrushesAttributes == textAttributes)
+    {
+        return S_OK;
+    }
+
     auto [fg, bg] = renderSettings.GetAttributeColorsWithAlpha(textAttributes);
     fg |= 0xff000000;
     bg |= _api.backgroundOpaqueMixin;
@@ -662,9 +672,12 @@ try
         _api.currentBackground = gsl::narrow_cast<u32>(bg);
         _api.currentForeground = gsl::narrow_cast<u32>(fg);
         _api.attributes = attributes;
+        _api.drawingBrushesAttributes = textAttributes;
     }
     else
     {
+        _api.drawingBrushesAttributes.reset();
+
         if (textAttributes.BackgroundIsDefault() && bg != _api.s->misc->backgroundColor)
         {
             _api.s.write()->misc.write()->backgroundColor = bg;
@@ -714,6 +727,10 @@ void AtlasEngine::_recreateFontDependentResources()
     _api.replacementCharacterFontFace.reset();
     _api.replacementCharacterGlyphIndex = 0;
     _api.replacementCharacterLookedUp = false;
+    _api.asciiFontFaces = {};
+    _api.asciiFontFacesLookedUp = {};
+    _api.fallbackFontFaces.clear();
+    _api.shapingCache.clear();
 
     {
         wchar_t localeName[LOCALE_NAME_MAX_LENGTH];
@@ -863,13 +880,39 @@ void AtlasEngine::_mapRegularText(size_t offBeg, size_t offEnd)
 {
     auto& row = *_p.rows[_api.lastPaintBufferLineCoord.y];
 
+    // The lookahead result of the merge loop below, if it mapped to a different font face.
+    u32 nextLength = 0;
+    wil::com_ptr<IDWriteFontFace2> nextFontFace;
+
     for (u32 idx = gsl::narrow_cast<u32>(offBeg), mappedEnd = 0; idx < offEnd; idx = mappedEnd)
     {
         u32 mappedLength = 0;
         wil::com_ptr<IDWriteFontFace2> mappedFontFace;
-        _mapCharacters(_api.bufferLine.data() + idx, gsl::narrow_cast<u32>(offEnd - idx), &mappedLength, mappedFontFace.addressof());
+        if (nextLength)
+        {
+            mappedLength = std::exchange(nextLength, 0);
+            mappedFontFace = std::move(nextFontFace);
+        }
+        else
+        {
+            _mapCharactersCached(_api.bufferLine.data() + idx, gsl::narrow_cast<u32>(offEnd - idx), &mappedLength, mappedFontFace.addressof());
+        }
         mappedEnd = idx + mappedLength;
 
+        // _mapCharactersCached() splits the text into multiple segments even if they map to the same font face,
+        // for instance at the end of a run of ASCII. Shaping them separately would break ligatures and kerning
+        // across the boundary (e.g. "=>" followed by U+00E9), so we merge them back together before calling GetTextComplexity().
+        while (mappedFontFace && mappedEnd < offEnd)
+        {
+            _mapCharactersCached(_api.bufferLine.data() + mappedEnd, gsl::narrow_cast<u32>(offEnd - mappedEnd), &nextLength, nextFontFace.put());
+            if (nextFontFace != mappedFontFace)
+            {
+                break;
+            }
+            mappedEnd += std::exchange(nextLength, 0);
+        }
+        mappedLength = mappedEnd - idx;
+
         if (!mappedFontFace)
         {
             _mapReplacementCharacter(idx, mappedEnd, row);
@@ -1019,6 +1062,99 @@ void AtlasEngine::_mapCharacters(const wchar_t* text, const u32 textLength, u32*
     assert(scale == 1);
 }
 
+// IDWriteFontFallback::MapCharacters() is slow and called for every run of text we paint, all while the
+// console lock is held. Most text is printable ASCII however, which always maps to the same font face as
+// long as the font covers all of it. This function looks that face up once and skips MapCharacters() for it.
+void AtlasEngine::_mapCharactersCached(const wchar_t* text, const u32 textLength, u32* mappedLength, IDWriteFontFace2** mappedFontFace)
+{
+    u32 asciiLength = 0;
+    for (; asciiLength < textLength && text[asciiLength] >= 0x20 && text[asciiLength] < 0x7f; ++asciiLength)
+    {
+    }
+    // The last ASCII character may be the base of a combining mark that follows it.
+    // It must be mapped together with that mark, so we leave it to MapCharacters().
+    if (asciiLength != 0 && asciiLength < textLength)
+    {
+        asciiLength--;
+    }
+
+    if (asciiLength != 0)
+    {
+        const auto idx = static_cast<size_t>(_api.attributes);
+        auto& fontFace = til::at(_api.asciiFontFaces, idx);
+
+        if (!til::at(_api.asciiFontFacesLookedUp, idx))
+        {
+            til::at(_api.asciiFontFacesLookedUp, idx) = true;
+
+            wchar_t ascii[0x7f - 0x20];
+            for (u32 i = 0; i < std::size(ascii); ++i)
+            {
+                til::at(ascii, i) = static_cast<wchar_t>(0x20 + i);
+            }
+
+            u32 length = 0;
+            _mapCharacters(&ascii[0], gsl::narrow_cast<u32>(std::size(ascii)), &length, fontFace.put());
+
+            // If the font doesn't cover all of ASCII, MapCharacters() needs to be asked every time.
+            if (length != std::size(ascii))
+            {
+                fontFace.reset();
+            }
+        }
+
+        if (fontFace)
+        {
+            *mappedLength = asciiLength;
+            fontFace.copy_to(mappedFontFace);
+            return;
+        }
+    }
+
+    // The other common case is CJK text in file names and logs. These characters stand on their
+    // own and don't combine with their neighbors the way emoji or Indic scripts do. That means we
+    // can cache the font face per character and only ask MapCharacters() once for each of them.
+    u32 standaloneLength = 0;
+    for (; standaloneLength < textLength && til::is_standalone_wide(text[standaloneLength]); ++standaloneLength)
+    {
+    }
+    // Same as above: The last character may be followed by a combining mark or variation selector.
+    if (standaloneLength != 0 && standaloneLength < textLength)
+    {
+        standaloneLength--;
+    }
+
+    if (standaloneLength != 0)
+    {
+        const auto lookup = [&](wchar_t ch) -> const wil::com_ptr<IDWriteFontFace2>& {
+            const auto key = static_cast<u32>(_api.attributes) << 16 | ch;
+            const auto [it, inserted] = _api.fallbackFontFaces.try_emplace(key);
+            if (inserted)
+            {
+                // A null font face means that no font covers the character, just like with MapCharacters().
+                auto cleanup = wil::scope_exit([&] { _api.fallbackFontFaces.erase(it); });
+                u32 length = 0;
+                _mapCharacters(&ch, 1, &length, it->second.put());
+                cleanup.release();
+            }
+            return it->second;
+        };
+
+        const auto& fontFace = lookup(text[0]);
+        u32 length = 1;
+        while (length < standaloneLength && lookup(text[length]) == fontFace)
+        {
+            ++length;
+        }
+
+        *mappedLength = length;
+        fontFace.copy_to(mappedFontFace);
+        return;
+    }
+
+    _mapCharacters(text, textLength, mappedLength, mappedFontFace);
+}
+
 void AtlasEngine::_mapComplex(IDWriteFontFace2* mappedFontFace, u32 idx, u32 length, ShapedRow& row)
 {
     _api.analysisResults.clear();
@@ -1059,73 +1195,57 @@ void AtlasEngine::_mapComplex(IDWriteFontFace2* mappedFontFace, u32 idx, u32 len
             _api.textProps = Buffer<DWRITE_SHAPING_TEXT_PROPERTIES>{ a.textLength };
         }
 
-        for (auto retry = 0;;)
+        // The font features and size are part of the font settings, which clear the cache when they change.
+        // Everything else that affects GetGlyphs()/GetGlyphPlacements() is part of this key.
+        auto& key = _api.shapingCacheKey;
+        const auto fontFacePtr = reinterpret_cast<uintptr_t>(mappedFontFace);
+        key.clear();
+        key.append(reinterpret_cast<const wchar_t*>(&fontFacePtr), sizeof(fontFacePtr) / sizeof(wchar_t));
+        key.push_back(static_cast<wchar_t>(a.analysis.script));
+        key.push_back(static_cast<wchar_t>(a.analysis.shapes));
+        key.append(_api.bufferLine.data() + a.textPosition, a.textLength);
+
+        if (const auto it = _api.shapingCache.find(key); it != _api.shapingCache.end())
         {
-            const auto hr = _p.textAnalyzer->GetGlyphs(
-                /* textString          */ _api.bufferLine.data() + a.textPosition,
-                /* textLength          */ a.textLength,
-                /* fontFace            */ mappedFontFace,
-                /* isSideways          */ false,
-                /* isRightToLeft       */ 0,
-                /* scriptAnalysis      */ &a.analysis,
-                /* localeName          */ _p.userLocaleName.c_str(),
-                /* numberSubstitution  */ nullptr,
-                /* features            */ &features,
-                /* featureRangeLengths */ &featureRangeLengths,
-                /* featureRanges       */ featureRanges,
-                /* maxGlyphCount       */ gsl::narrow_cast<u32>(_api.glyphIndices.size()),
-                /* clusterMap          */ _api.clusterMap.data(),
-                /* textProps           */ _api.textProps.data(),
-                /* glyphIndices        */ _api.glyphIndices.data(),
-                /* glyphProps          */ _api.glyphProps.data(),
-                /* actualGlyphCount    */ &actualGlyphCount);
-
-            if (hr == HRESULT_FROM_WIN32(ERROR_INSUFFICIENT_BUFFER) && ++retry < 8)
+            const auto& entry = it->second;
+            actualGlyphCount = gsl::narrow_cast<u32>(entry.glyphIndices.size());
+
+            if (_api.glyphIndices.size() < actualGlyphCount)
             {
-                // Grow factor 1.5x.
-                auto size = _api.glyphIndices.size();
-                size = size + (size >> 1);
-                // Overflow check.
-                Expects(size > _api.glyphIndices.size());
-                _api.glyphIndices = Buffer<u16>{ size };
-                _api.glyphProps = Buffer<DWRITE_SHAPING_GLYPH_PROPERTIES>{ size };
-                continue;
+                _api.glyphIndices = Buffer<u16>{ actualGlyphCount };
+                _api.glyphProps = Buffer<DWRITE_SHAPING_GLYPH_PROPERTIES>{ actualGlyphCount };
+            }
+            if (_api.glyphAdvances.size() < actualGlyphCount)
+            {
+                _api.glyphAdvances = Buffer<f32>{ actualGlyphCount };
+                _api.glyphOffsets = Buffer<DWRITE_GLYPH_OFFSET>{ actualGlyphCount };
             }
 
-            THROW_IF_FAILED(hr);
-            break;
+            std::copy(entry.clusterMap.begin(), entry.clusterMap.end(), _api.clusterMap.begin());
+            std::copy(entry.glyphIndices.begin(), entry.glyphIndices.end(), _api.glyphIndices.begin());
+            std::copy(entry.glyphProps.begin(), entry.glyphProps.end(), _api.glyphProps.begin());
+            std::copy(entry.glyphAdvances.begin(), entry.glyphAdvances.end(), _api.glyphAdvances.begin());
+            std::copy(entry.glyphOffsets.begin(), entry.glyphOffsets.end(), _api.glyphOffsets.begin());
         }
-
-        if (_api.glyphAdvances.size() < actualGlyphCount)
+        else
         {
-            // Grow the buffer by at least 1.5x and at least of `actualGlyphCount` items.
-            // The 1.5x growth ensures we don't reallocate every time we need 1 more slot.
-            auto size = _api.glyphAdvances.size();
-            size = size + (size >> 1);
-            size = std::max<size_t>(size, actualGlyphCount);
-            _api.glyphAdvances = Buffer<f32>{ size };
-            _api.glyphOffsets = Buffer<DWRITE_GLYPH_OFFSET>{ size };
-        }
+            _shapeComplex(mappedFontFace, a, &features, &featureRangeLengths, featureRanges, actualGlyphCount);
 
-        THROW_IF_FAILED(_p.textAnalyzer->GetGlyphPlacements(
-            /* textString          */ _api.bufferLine.data() + a.textPosition,
-            /* clusterMap          */ _api.clusterMap.data(),
-            /* textProps           */ _api.textProps.data(),
-            /* textLength          */ a.textLength,
-            /* glyphIndices        */ _api.glyphIndices.data(),
-            /* glyphProps          */ _api.glyphProps.data(),
-            /* glyphCount          */ actualGlyphCount,
-            /* fontFace            */ mappedFontFace,
-            /* fontEmSize          */ _p.s->font->fontSize,
-            /* isSideways          */ false,
-            /* isRightToLeft       */ 0,
-            /* scriptAnalysis      */ &a.analysis,
-            /* localeName          */ _p.userLocaleName.c_str(),
-            /* features            */ &features,
-            /* featureRangeLengths */ &featureRangeLengths,
-            /* featureRanges       */ featureRanges,
-            /* glyphAdvances       */ _api.glyphAdvances.data(),
-            /* glyphOffsets        */ _api.glyphOffsets.data()));
+            if (_api.shapingCache.size() >= shapingCacheCapacity)
+            {
+                _api.shapingCache.clear();
+            }
+
+            _api.shapingCache.emplace(key,
+                                      ShapingCacheEntry{
+                                          .fontFace = mappedFontFace,
+                                          .clusterMap = { _api.clusterMap.begin(), _api.clusterMap.begin() + a.textLength },
+                                          .glyphIndices = { _api.glyphIndices.begin(), _api.glyphIndices.begin() + actualGlyphCount },
+                                          .glyphProps = { _api.glyphProps.begin(), _api.glyphProps.begin() + actualGlyphCount },
+                                          .glyphAdvances = { _api.glyphAdvances.begin(), _api.glyphAdvances.begin() + actualGlyphCount },
+                                          .glyphOffsets = { _api.glyphOffsets.begin(), _api.glyphOffsets.begin() + actualGlyphCount },
+                                      });
+        }
 
         _api.clusterMap[a.textLength] = gsl::narrow_cast<u16>(actualGlyphCount);
 
@@ -1166,6 +1286,79 @@ void AtlasEngine::_mapComplex(IDWriteFontFace2* mappedFontFace, u32 idx, u32 len
     }
 }
 
+// Runs GetGlyphs() and GetGlyphPlacements() for the given script run and stores the results
+// in _api.clusterMap/textProps/glyphIndices/glyphProps/glyphAdvances/glyphOffsets.
+void AtlasEngine::_shapeComplex(IDWriteFontFace2* mappedFontFace, const TextAnalysisSinkResult& a, const DWRITE_TYPOGRAPHIC_FEATURES** features, const u32* featureRangeLengths, const u32 featureRanges, u32& actualGlyphCount)
+{
+    for (auto retry = 0;;)
+    {
+        const auto hr = _p.textAnalyzer->GetGlyphs(
+            /* textString          */ _api.bufferLine.data() + a.textPosition,
+            /* textLength          */ a.textLength,
+            /* fontFace            */ mappedFontFace,
+            /* isSideways          */ false,
+            /* isRightToLeft       */ 0,
+            /* scriptAnalysis      */ &a.analysis,
+            /* localeName          */ _p.userLocaleName.c_str(),
+            /* numberSubstitution  */ nullptr,
+            /* features            */ features,
+            /* featureRangeLengths */ featureRangeLengths,
+            /* featureRanges       */ featureRanges,
+            /* maxGlyphCount       */ gsl::narrow_cast<u32>(_api.glyphIndices.size()),
+            /* clusterMap          */ _api.clusterMap.data(),
+            /* textProps           */ _api.textProps.data(),
+            /* glyphIndices        */ _api.glyphIndices.data(),
+            /* glyphProps          */ _api.glyphProps.data(),
+            /* actualGlyphCount    */ &actualGlyphCount);
+
+        if (hr == HRESULT_FROM_WIN32(ERROR_INSUFFICIENT_BUFFER) && ++retry < 8)
+        {
+            // Grow factor 1.5x.
+            auto size = _api.glyphIndices.size();
+            size = size + (size >> 1);
+            // Overflow check.
+            Expects(size > _api.glyphIndices.size());
+            _api.glyphIndices = Buffer<u16>{ size };
+            _api.glyphProps = Buffer<DWRITE_SHAPING_GLYPH_PROPERTIES>{ size };
+            continue;
+        }
+
+        THROW_IF_FAILED(hr);
+        break;
+    }
+
+    if (_api.glyphAdvances.size() < actualGlyphCount)
+    {
+        // Grow the buffer by at least 1.5x and at least of `actualGlyphCount` items.
+        // The 1.5x growth ensures we don't reallocate every time we need 1 more slot.
+        auto size = _api.glyphAdvances.size();
+        size = size + (size >> 1);
+        size = std::max<size_t>(size, actualGlyphCount);
+        _api.glyphAdvances = Buffer<f32>{ size };
+        _api.glyphOffsets = Buffer<DWRITE_GLYPH_OFFSET>{ size };
+    }
+
+    THROW_IF_FAILED(_p.textAnalyzer->GetGlyphPlacements(
+        /* textString          */ _api.bufferLine.data() + a.textPosition,
+        /* clusterMap          */ _api.clusterMap.data(),
+        /* textProps           */ _api.textProps.data(),
+        /* textLength          */ a.textLength,
+        /* glyphIndices        */ _api.glyphIndices.data(),
+        /* glyphProps          */ _api.glyphProps.data(),
+        /* glyphCount          */ actualGlyphCount,
+        /* fontFace            */ mappedFontFace,
+        /* fontEmSize          */ _p.s->font->fontSize,
+        /* isSideways          */ false,
+        /* isRightToLeft       */ 0,
+        /* scriptAnalysis      */ &a.analysis,
+        /* localeName          */ _p.userLocaleName.c_str(),
+        /* features            */ features,
+        /* featureRangeLengths */ featureRangeLengths,
+        /* featureRanges       */ featureRanges,
+        /* glyphAdvances       */ _api.glyphAdvances.data(),
+        /* glyphOffsets        */ _api.glyphOffsets.data()));
+}
+
 void AtlasEngine::_mapReplacementCharacter(u32 from, u32 to, ShapedRow& row)
 {
     if (!_api.replacementCharacterLookedUp)
@@ -77,6 +77,9 @@ namespace Microsoft::Console::Render::Atlas
         void SetWarningCallback(std::function<void(HRESULT, wil::zwstring_view)> pfn) noexcept;
         [[nodiscard]] HRESULT SetWindowSize(til::size pixels) noexcept;
         [[nodiscard]] HRESULT UpdateFont(const FontInfoDesired& pfiFontInfoDesired, FontInfo& fiFontInfo, const std::unordered_map<std::wstring_view, float>& features, const std::unordered_map<std::wstring_view, float>& axes) noexcept;
+        // Frees the swap chain, the backend (including the glyph atlas) and the D3D device.
+        // They'll be recreated with the next frame. Must not be called while the renderer is painting.
+        void ReleaseResources() noexcept;
 
     private:
         // AtlasEngine.cpp
@@ -87,7 +90,9 @@ namespace Microsoft::Console::Render::Atlas
         void _mapRegularText(size_t offBeg, size_t offEnd);
         void _mapBuiltinGlyphs(size_t offBeg, size_t offEnd);
         void _mapCharacters(const wchar_t* text, u32 textLength, u32* mappedLength, IDWriteFontFace2** mappedFontFace) const;
+        void _mapCharactersCached(const wchar_t* text, u32 textLength, u32* mappedLength, IDWriteFontFace2** mappedFontFace);
         void _mapComplex(IDWriteFontFace2* mappedFontFace, u32 idx, u32 length, ShapedRow& row);
+        void _shapeComplex(IDWriteFontFace2* mappedFontFace, const TextAnalysisSinkResult& a, const DWRITE_TYPOGRAPHIC_FEATURES** features, const u32* featureRangeLengths, u32 featureRanges, u32& actualGlyphCount);
         ATLAS_ATTR_COLD void _mapReplacementCharacter(u32 from, u32 to, ShapedRow& row);
         void _fillColorBitmap(const size_t y, const size_t x1, const size_t x2, const u32 fgColor, const u32 bgColor) noexcept;
         [[nodiscard]] HRESULT _drawHighlighted(std::span<const til::point_span>& highlights, const u16 row, const u16 begX, const u16 endX, const u32 fgColor, const u32 bgColor) noexcept;
@@ -123,6 +128,22 @@ namespace Microsoft::Console::Render::Atlas
         static constexpr u32 highlightFocusBg = 0xff3296ff;
         static constexpr u32 highlightFocusFg = 0xff000000;
 
+        // The results of GetGlyphs() and GetGlyphPlacements() for a single script run. See _mapComplex().
+        struct ShapingCacheEntry
+        {
+            // Keeps the font face alive, because its address is part of the cache key.
+            wil::com_ptr<IDWriteFontFace2> fontFace;
+            std::vector<u16> clusterMap;
+            std::vector<u16> glyphIndices;
+            std::vector<DWRITE_SHAPING_GLYPH_PROPERTIES> glyphProps;
+            std::vector<f32> glyphAdvances;
+            std::vector<DWRITE_GLYPH_OFFSET> glyphOffsets;
+        };
+
+        // Prompts, progress bars and `watch` redraw the same complex text over and
+        // over again. This bounds how many shaping results we keep around for that.
+        static constexpr size_t shapingCacheCapacity = 256;
+
         std::unique_ptr<IBackend> _b;
         RenderingPayload _p;
 
@@ -150,11 +171,19 @@ namespace Microsoft::Console::Render::Atlas
             Buffer<DWRITE_SHAPING_GLYPH_PROPERTIES> glyphProps;
             Buffer<f32> glyphAdvances;
             Buffer<DWRITE_GLYPH_OFFSET> glyphOffsets;
+            // The key consists of the font face pointer, the script analysis and the text. See _mapComplex().
+            std::unordered_map<std::wstring, ShapingCacheEntry> shapingCache;
+            std::wstring shapingCacheKey;
 
             wil::com_ptr<IDWriteFontFallback> systemFontFallback;
             wil::com_ptr<IDWriteFontFace2> replacementCharacterFontFace;
             u16 replacementCharacterGlyphIndex = 0;
             bool replacementCharacterLookedUp = false;
+            // The font face printable ASCII maps to, indexed by FontRelevantAttributes. See _mapCharactersCached().
+            std::array<wil::com_ptr<IDWriteFontFace2>, 4> asciiFontFaces;
+            std::array<bool, 4> asciiFontFacesLookedUp{};
+            // The font face of individual CJK characters. The key is (FontRelevantAttributes << 16 | char).
+            std::unordered_map<u32, wil::com_ptr<IDWriteFontFace2>> fallbackFontFaces;
 
             // PrepareLineTransform()
             LineRendition lineRendition = LineRendition::SingleWidth;
@@ -163,6 +192,8 @@ namespace Microsoft::Console::Render::Atlas
             u32 currentBackground = 0;
             u32 currentForeground = 0;
             FontRelevantAttributes attributes = FontRelevantAttributes::None;
+            // The attributes the above currentBackground/Foreground/attributes were computed from during this frame.
+            std::optional<TextAttribute> drawingBrushesAttributes;
             u16x2 lastPaintBufferLineCoord{};
             // UpdateHyperlinkHoveredId()
             u16 hyperlinkHoveredId = 0;
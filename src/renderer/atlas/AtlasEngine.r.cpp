@@ -32,7 +32,10 @@ using namespace Microsoft::Console::Render::Atlas;
 [[nodiscard]] HRESULT AtlasEngine::Present() noexcept
 try
 {
-    if (!_p.dxgi.adapter)
+    // IsCurrent() turns false when the set of adapters changes (a dock or eGPU got attached, a driver got updated, etc.),
+    // which may mean that there's now a different default adapter. _recreateAdapter() only resets the backend if the LUID changed.
+    // Since the factory is replaced either way, _createSwapChain() gets the factory from the device instead.
+    if (!_p.dxgi.adapter || !_p.dxgi.factory->IsCurrent())
     {
         _recreateAdapter();
     }
@@ -91,6 +94,16 @@ void AtlasEngine::WaitUntilCanRender() noexcept
 
 #pragma endregion
 
+void AtlasEngine::ReleaseResources() noexcept
+try
+{
+    _destroySwapChain();
+    _b.reset();
+    _p.deviceContext.reset();
+    _p.device.reset();
+}
+CATCH_LOG()
+
 void AtlasEngine::_recreateAdapter()
 {
 #ifndef NDEBUG
@@ -314,13 +327,34 @@ void AtlasEngine::_handleSwapChainUpdate()
 
 static constexpr DXGI_SWAP_CHAIN_FLAG swapChainFlags = ATLAS_DEBUG_DISABLE_FRAME_LATENCY_WAITABLE_OBJECT ? DXGI_SWAP_CHAIN_FLAG{} : DXGI_SWAP_CHAIN_FLAG_FRAME_LATENCY_WAITABLE_OBJECT;
 
+// Composition swap chains support IDXGISwapChain2::SetSourceSize(), which allows us to show just the top-left
+// part of a larger allocation. Rounding the allocation up to a multiple of this granularity means that
+// dragging the window border only has to reallocate the buffers every few dozen pixels and not every frame.
+static constexpr u16 swapChainSizeGranularity = 64;
+
+static u16x2 swapChainBufferSize(const RenderingPayload& p) noexcept
+{
+    const auto targetSize = p.s->targetSize;
+    if (p.s->target->hwnd)
+    {
+        return targetSize;
+    }
+
+    static constexpr u32 mask = swapChainSizeGranularity - 1;
+    const auto alignX = std::min<u32>((targetSize.x + mask) & ~mask, D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION);
+    const auto alignY = std::min<u32>((targetSize.y + mask) & ~mask, D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION);
+    return { gsl::narrow_cast<u16>(alignX), gsl::narrow_cast<u16>(alignY) };
+}
+
 void AtlasEngine::_createSwapChain()
 {
     _destroySwapChain();
 
+    const auto bufferSize = swapChainBufferSize(_p);
+
     DXGI_SWAP_CHAIN_DESC1 desc{
-        .Width = _p.s->targetSize.x,
-        .Height = _p.s->targetSize.y,
+        .Width = bufferSize.x,
+        .Height = bufferSize.y,
         .Format = DXGI_FORMAT_B8G8R8A8_UNORM,
         .SampleDesc = { .Count = 1 },
         .BufferUsage = DXGI_USAGE_RENDER_TARGET_OUTPUT,
@@ -344,13 +378,21 @@ void AtlasEngine::_createSwapChain()
         .Flags = swapChainFlags,
     };
 
+    // The swap chain must be created by the factory that the device's adapter came from. That's not necessarily
+    // _p.dxgi.factory, because _recreateAdapter() replaces it whenever IsCurrent() turns false, but
+    // keeps the existing adapter and device around if the default adapter's LUID didn't change.
+    wil::com_ptr<IDXGIAdapter> deviceAdapter;
+    THROW_IF_FAILED(_p.device.query<IDXGIDevice>()->GetAdapter(deviceAdapter.addressof()));
+    wil::com_ptr<IDXGIFactory2> factory;
+    THROW_IF_FAILED(deviceAdapter->GetParent(IID_PPV_ARGS(factory.addressof())));
+
     wil::com_ptr<IDXGISwapChain1> swapChain1;
     wil::unique_handle handle;
 
     if (_p.s->target->hwnd)
     {
         desc.AlphaMode = DXGI_ALPHA_MODE_IGNORE;
-        THROW_IF_FAILED(_p.dxgi.factory->CreateSwapChainForHwnd(_p.device.get(), _p.s->target->hwnd, &desc, nullptr, nullptr, swapChain1.addressof()));
+        THROW_IF_FAILED(factory->CreateSwapChainForHwnd(_p.device.get(), _p.s->target->hwnd, &desc, nullptr, nullptr, swapChain1.addressof()));
     }
     else
     {
@@ -361,7 +403,7 @@ void AtlasEngine::_createSwapChain()
         // As per: https://docs.microsoft.com/en-us/windows/win32/api/dcomp/nf-dcomp-dcompositioncreatesurfacehandle
         static constexpr DWORD COMPOSITIONSURFACE_ALL_ACCESS = 0x0003L;
         THROW_IF_FAILED(DCompositionCreateSurfaceHandle(COMPOSITIONSURFACE_ALL_ACCESS, nullptr, handle.addressof()));
-        THROW_IF_FAILED(_p.dxgi.factory.query<IDXGIFactoryMedia>()->CreateSwapChainForCompositionSurfaceHandle(_p.device.get(), handle.get(), &desc, nullptr, swapChain1.addressof()));
+        THROW_IF_FAILED(factory.query<IDXGIFactoryMedia>()->CreateSwapChainForCompositionSurfaceHandle(_p.device.get(), handle.get(), &desc, nullptr, swapChain1.addressof()));
     }
 
     _p.swapChain.swapChain = swapChain1.query<IDXGISwapChain2>();
@@ -369,10 +411,16 @@ void AtlasEngine::_createSwapChain()
     _p.swapChain.frameLatencyWaitableObject.reset(_p.swapChain.swapChain->GetFrameLatencyWaitableObject());
     _p.swapChain.targetGeneration = _p.s->target.generation();
     _p.swapChain.targetSize = _p.s->targetSize;
+    _p.swapChain.bufferSize = bufferSize;
     _p.swapChain.waitForPresentation = true;
 
     LOG_IF_FAILED(_p.swapChain.swapChain->SetMaximumFrameLatency(1));
 
+    if (!_p.s->target->hwnd)
+    {
+        THROW_IF_FAILED(_p.swapChain.swapChain->SetSourceSize(_p.s->targetSize.x, _p.s->targetSize.y));
+    }
+
     WaitUntilCanRender();
 
     if (_p.swapChainChangedCallback)
@@ -406,10 +454,22 @@ void AtlasEngine::_destroySwapChain()
 
 void AtlasEngine::_resizeBuffers()
 {
+    // The backends still need to recreate anything that depends on the target size (like the custom shader's
+    // offscreen texture), even if the swap chain's allocation itself can be reused below.
     _b->ReleaseResources();
     _p.deviceContext->ClearState();
 
-    THROW_IF_FAILED(_p.swapChain.swapChain->ResizeBuffers(0, _p.s->targetSize.x, _p.s->targetSize.y, DXGI_FORMAT_UNKNOWN, swapChainFlags));
+    const auto bufferSize = swapChainBufferSize(_p);
+    if (_p.swapChain.bufferSize != bufferSize)
+    {
+        THROW_IF_FAILED(_p.swapChain.swapChain->ResizeBuffers(0, bufferSize.x, bufferSize.y, DXGI_FORMAT_UNKNOWN, swapChainFlags));
+        _p.swapChain.bufferSize = bufferSize;
+    }
+    if (!_p.s->target->hwnd)
+    {
+        THROW_IF_FAILED(_p.swapChain.swapChain->SetSourceSize(_p.s->targetSize.x, _p.s->targetSize.y));
+    }
+
     _p.swapChain.targetSize = _p.s->targetSize;
 }
 
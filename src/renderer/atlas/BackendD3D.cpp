@@ -264,7 +264,15 @@ void BackendD3D::_handleSettingsUpdate(const RenderingPayload& p)
     }
     if (miscChanged)
     {
-        _recreateCustomShader(p);
+        // The miscellaneous settings also contain the default colors, which can change frequently (e.g. OSC 11).
+        // Compiling a custom shader is expensive however, so we avoid doing that unless its inputs actually changed.
+        const auto& misc = *p.s->misc;
+        if (_customShaderPath != misc.customPixelShaderPath ||
+            _customShaderImagePath != misc.customPixelShaderImagePath ||
+            _customShaderUseRetroTerminalEffect != misc.useRetroTerminalEffect)
+        {
+            _recreateCustomShader(p);
+        }
     }
     if (cellCountChanged)
     {
@@ -362,6 +370,10 @@ void BackendD3D::_d2dRenderTargetUpdateFontSettings(const RenderingPayload& p) c
 
 void BackendD3D::_recreateCustomShader(const RenderingPayload& p)
 {
+    _customShaderPath = p.s->misc->customPixelShaderPath;
+    _customShaderImagePath = p.s->misc->customPixelShaderImagePath;
+    _customShaderUseRetroTerminalEffect = p.s->misc->useRetroTerminalEffect;
+
     _customRenderTargetView.reset();
     _customOffscreenTexture.reset();
     _customOffscreenTextureView.reset();
@@ -787,6 +799,17 @@ void BackendD3D::_resetGlyphAtlas(const RenderingPayload& p, u32 minWidth, u32 m
         v = 1u << (index + 1);
     }
 
+    const auto oldWidth = gsl::narrow_cast<u16>(_rectPacker.width);
+    const auto oldHeight = gsl::narrow_cast<u16>(_rectPacker.height);
+    // If the atlas merely grows, we can keep all the glyphs we've already rasterized, by copying
+    // the old texture into the top-left corner of the new one. This avoids re-rasterizing everything
+    // on screen every time a CJK or emoji heavy output fills up the atlas until it reaches its max. size.
+    wil::com_ptr<ID3D11Texture2D> oldGlyphAtlas;
+    if (!_fontChangedResetGlyphAtlas && _glyphAtlas && u >= oldWidth && v >= oldHeight && (u != oldWidth || v != oldHeight))
+    {
+        oldGlyphAtlas = _glyphAtlas;
+    }
+
     if (u != _rectPacker.width || v != _rectPacker.height)
     {
         _resizeGlyphAtlas(p, u, v);
@@ -794,6 +817,28 @@ void BackendD3D::_resetGlyphAtlas(const RenderingPayload& p, u32 minWidth, u32 m
 
     stbrp_init_target(&_rectPacker, u, v, _rectPackerData.data(), _rectPackerData.size());
 
+    if (oldGlyphAtlas)
+    {
+        // The first rectangle in an empty skyline always ends up in the top-left corner.
+        // This reserves the area of the old atlas and we copy its contents into it.
+        stbrp_rect rect{ .w = oldWidth, .h = oldHeight };
+        if (stbrp_pack_rects(&_rectPacker, &rect, 1) && rect.x == 0 && rect.y == 0)
+        {
+            // Clear the new texture first, because its contents are undefined and
+            // the rest of it will be used for new glyphs which are drawn with blending.
+            _d2dBeginDrawing();
+            _d2dRenderTarget->Clear();
+            _d2dEndDrawing();
+
+            p.deviceContext->CopySubresourceRegion(_glyphAtlas.get(), 0, 0, 0, 0, oldGlyphAtlas.get(), 0, nullptr);
+
+            _d2dBeginDrawing();
+            return;
+        }
+
+        stbrp_init_target(&_rectPacker, u, v, _rectPackerData.data(), _rectPackerData.size());
+    }
+
     // This is a little imperfect, because it only releases the memory of the glyph mappings, not the memory held by
     // any DirectWrite fonts. On the other side, the amount of fonts on a system is always finite, where "finite"
     // is pretty low, relatively speaking. Additionally this allows us to cache the boxGlyphs map indefinitely.
@@ -999,11 +1044,44 @@ void BackendD3D::_flushQuads(const RenderingPayload& p)
         _recreateInstanceBuffers(p);
     }
 
+    // With mostly static contents, most frames only differ in a few instances (for instance the cursor).
+    // We only upload the range of instances that differs from the previous upload, because re-uploading
+    // the entire buffer every frame is a waste of bandwidth, especially on high refresh rate displays.
     {
-        D3D11_MAPPED_SUBRESOURCE mapped{};
-        THROW_IF_FAILED(p.deviceContext->Map(_instanceBuffer.get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped));
-        memcpy(mapped.pData, _instances.data(), _instancesCount * sizeof(QuadInstance));
-        p.deviceContext->Unmap(_instanceBuffer.get(), 0);
+        static constexpr auto stride = sizeof(QuadInstance);
+        const auto newBeg = reinterpret_cast<const u8*>(_instances.data());
+        const auto newEnd = newBeg + _instancesCount * stride;
+        const auto oldBeg = reinterpret_cast<const u8*>(_instancesUploaded.data());
+        const auto oldEnd = oldBeg + _instancesUploadedCount * stride;
+
+        auto first = static_cast<size_t>(std::mismatch(newBeg, newEnd, oldBeg, oldEnd).first - newBeg);
+        auto last = _instancesCount * stride;
+
+        if (_instancesCount == _instancesUploadedCount && first != last)
+        {
+            const auto it = std::mismatch(std::make_reverse_iterator(newEnd), std::make_reverse_iterator(newBeg + first), std::make_reverse_iterator(oldEnd));
+            last = static_cast<size_t>(it.first.base() - newBeg);
+        }
+
+        // Round the byte offsets to whole instances.
+        first = first / stride * stride;
+        last = (last + stride - 1) / stride * stride;
+
+        if (first < last)
+        {
+            const D3D11_BOX box{
+                .left = gsl::narrow_cast<UINT>(first),
+                .top = 0,
+                .front = 0,
+                .right = gsl::narrow_cast<UINT>(last),
+                .bottom = 1,
+                .back = 1,
+            };
+            p.deviceContext->UpdateSubresource(_instanceBuffer.get(), 0, &box, newBeg + first, 0, 0);
+            memcpy(reinterpret_cast<u8*>(_instancesUploaded.data()) + first, newBeg + first, last - first);
+        }
+
+        _instancesUploadedCount = _instancesCount;
     }
 
     // I found 4 approaches to drawing lots of quads quickly. There are probably even more.
@@ -1043,16 +1121,20 @@ void BackendD3D::_recreateInstanceBuffers(const RenderingPayload& p)
     _instanceBuffer.reset();
 
     {
+        // This is a default buffer instead of a dynamic one, because _flushQuads() only updates parts of it.
         const D3D11_BUFFER_DESC desc{
             .ByteWidth = gsl::narrow<UINT>(newSize),
-            .Usage = D3D11_USAGE_DYNAMIC,
+            .Usage = D3D11_USAGE_DEFAULT,
             .BindFlags = D3D11_BIND_VERTEX_BUFFER,
-            .CPUAccessFlags = D3D11_CPU_ACCESS_WRITE,
             .StructureByteStride = sizeof(QuadInstance),
         };
         THROW_IF_FAILED(p.device->CreateBuffer(&desc, nullptr, _instanceBuffer.addressof()));
     }
 
+    // The new buffer's contents are undefined, so the next _flushQuads() needs to upload everything.
+    _instancesUploaded = Buffer<QuadInstance, 32>{ newCapacity };
+    _instancesUploadedCount = 0;
+
     // IA: Input Assembler
     ID3D11Buffer* vertexBuffers[]{ _vertexBuffer.get(), _instanceBuffer.get() };
     static constexpr UINT strides[]{ sizeof(f32x2), sizeof(QuadInstance) };
@@ -276,6 +276,9 @@ namespace Microsoft::Console::Render::Atlas
         size_t _instanceBufferCapacity = 0;
         Buffer<QuadInstance, 32> _instances;
         size_t _instancesCount = 0;
+        // A copy of what the last _flushQuads() uploaded into _instanceBuffer. See _flushQuads().
+        Buffer<QuadInstance, 32> _instancesUploaded;
+        size_t _instancesUploadedCount = 0;
 
         wil::com_ptr<ID3D11RenderTargetView> _customRenderTargetView;
         wil::com_ptr<ID3D11Texture2D> _customOffscreenTexture;
@@ -288,6 +291,10 @@ namespace Microsoft::Console::Render::Atlas
         wil::com_ptr<ID3D11ShaderResourceView> _customShaderTextureView;
         u64 _customShaderPerfTickMod = 0;
         f32 _customShaderSecsPerPerfTick = 0;
+        // The inputs the custom shader was last created from. See _handleSettingsUpdate().
+        std::wstring _customShaderPath;
+        std::wstring _customShaderImagePath;
+        bool _customShaderUseRetroTerminalEffect = false;
 
         wil::com_ptr<ID3D11Texture2D> _backgroundBitmap;
         wil::com_ptr<ID3D11ShaderResourceView> _backgroundBitmapView;
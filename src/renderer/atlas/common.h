@@ -526,7 +526,10 @@ namespace Microsoft::Console::Render::Atlas
             til::generation_t generation;
             til::generation_t targetGeneration;
             til::generation_t fontGeneration;
+            // targetSize is the visible size of the swap chain, while bufferSize is its allocated size.
+            // They only differ for composition swap chains, which get over-allocated (see _createSwapChain).
             u16x2 targetSize{};
+            u16x2 bufferSize{};
             bool waitForPresentation = false;
         } swapChain;
         wil::com_ptr<ID3D11Device2> device;
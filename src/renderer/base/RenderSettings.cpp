@@ -46,9 +46,10 @@ void RenderSettings::RestoreDefaultSettings() noexcept
 {
     _colorTable = _defaultColorTable;
     _colorAliasIndices = _defaultColorAliasIndices;
-    // For now, DECSCNM is the only render mode we need to reset. The others are
-    // all user preferences that can't be changed programmatically.
-    _renderMode.reset(Mode::ScreenReversed);
+    // For now, DECSCNM and synchronized output are the only render modes we
+    // need to reset. The others are all user preferences that can't be changed
+    // programmatically.
+    _renderMode.reset(Mode::ScreenReversed, Mode::SynchronizedOutput);
 }
 
 // Routine Description:
@@ -206,7 +207,7 @@ std::pair<COLORREF, COLORREF> RenderSettings::GetAttributeColors(const TextAttri
             fg != bg &&
             (_renderMode.test(Mode::AlwaysDistinguishableColors) || (fgTextColor.IsDefaultOrLegacy() && bgTextColor.IsDefaultOrLegacy())))
         {
-            fg = ColorFix::GetPerceivableColor(fg, bg, 0.5f * 0.5f);
+            fg = _getPerceivableColor(fg, bg);
         }
     }
 
@@ -270,13 +271,40 @@ COLORREF RenderSettings::GetAttributeUnderlineColor(const TextAttribute& attr) c
             (_renderMode.test(Mode::AlwaysDistinguishableColors) ||
              (_renderMode.test(Mode::IndexedDistinguishableColors) && ulTextColor.IsDefaultOrLegacy() && attr.GetBackground().IsDefaultOrLegacy())))
         {
-            ul = ColorFix::GetPerceivableColor(ul, bg, 0.5f * 0.5f);
+            ul = _getPerceivableColor(ul, bg);
         }
     }
 
     return ul;
 }
 
+// Routine Description:
+// - Returns ColorFix::GetPerceivableColor(fg, bg), memoized in a small
+//   direct-mapped cache. The perceptual math is expensive and gets run
+//   for every attribute run on every frame, but the number of distinct
+//   color pairs on screen is usually tiny. Since the key consists of the
+//   resolved colors, the cache never needs to be invalidated.
+// Arguments:
+// - fg - The foreground color to adjust. Must be different from bg.
+// - bg - The background color to adjust against.
+// Return Value:
+// - The adjusted foreground color.
+COLORREF RenderSettings::_getPerceivableColor(const COLORREF fg, const COLORREF bg) const noexcept
+{
+    // Entries are zero-initialized and thus have fg == bg, which can never match a lookup.
+    const auto hash = (static_cast<uint32_t>(fg) ^ (static_cast<uint32_t>(bg) * 31u)) * 0x9E3779B1u;
+    auto& entry = til::at(_perceivableColorCache, hash >> (32 - PerceivableColorCacheBits));
+
+    if (entry.fg != fg || entry.bg != bg)
+    {
+        entry.fg = fg;
+        entry.bg = bg;
+        entry.result = ColorFix::GetPerceivableColor(fg, bg, 0.5f * 0.5f);
+    }
+
+    return entry.result;
+}
+
 // Routine Description:
 // - Increments the position in the blink cycle, toggling the blink rendition
 //   state on every second call, potentially triggering a redraw of the given
@@ -303,7 +331,7 @@ try
             _blinkIsInUse = false;
             if (renderer)
             {
-                renderer->TriggerRedrawAll();
+                renderer->TriggerRedrawBlinkingText();
             }
         }
     }
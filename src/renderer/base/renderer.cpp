@@ -3,6 +3,9 @@
 
 #include "precomp.h"
 #include "renderer.hpp"
+#include "tracing.hpp"
+
+#include <til/atomic.h>
 
 #pragma hdrstop
 
@@ -14,6 +17,8 @@ using PointTree = interval_tree::IntervalTree<til::point, size_t>;
 static constexpr auto maxRetriesForRenderEngine = 3;
 // The renderer will wait this number of milliseconds * how many tries have elapsed before trying again.
 static constexpr auto renderBackoffBaseTimeMilliseconds{ 150 };
+// The longest we'll hold off rendering while an application has the synchronized output mode enabled.
+static constexpr ULONGLONG synchronizedOutputTimeoutMilliseconds{ 100 };
 
 #define FOREACH_ENGINE(var)   \
     for (auto var : _engines) \
@@ -112,12 +117,30 @@ IRenderData* Renderer::GetRenderData() const noexcept
 
 [[nodiscard]] HRESULT Renderer::_PaintFrame() noexcept
 {
+    const auto trace = RenderTracing::IsEnabled();
+    std::chrono::steady_clock::time_point beg, locked, painted;
+
+    if (trace)
+    {
+        beg = std::chrono::steady_clock::now();
+    }
+
     {
         _pData->LockConsole();
         auto unlock = wil::scope_exit([&]() {
             _pData->UnlockConsole();
         });
 
+        if (_isSynchronizingOutput.load(std::memory_order_relaxed))
+        {
+            WaitForSynchronizedOutput();
+        }
+
+        if (trace)
+        {
+            locked = std::chrono::steady_clock::now();
+        }
+
         // Last chance check if anything scrolled without an explicit invalidate notification since the last frame.
         _CheckViewportAndScroll();
 
@@ -136,14 +159,59 @@ IRenderData* Renderer::GetRenderData() const noexcept
         }
     }
 
+    if (trace)
+    {
+        painted = std::chrono::steady_clock::now();
+    }
+
     FOREACH_ENGINE(pEngine)
     {
         RETURN_IF_FAILED(pEngine->Present());
     }
 
+    if (trace)
+    {
+        RenderTracing::TraceFrame(locked - beg, painted - locked, std::chrono::steady_clock::now() - painted);
+    }
+
     return S_OK;
 }
 
+// Routine Description:
+// - Waits for the application to finish its synchronized update (DECRST 2026),
+//   so that the entire update ends up in a single frame. The console lock must be
+//   held by the caller. It's released while waiting, since the application needs
+//   it to make progress. Applications may never end their update (e.g. if they
+//   crash), which is why we give up after a short timeout.
+// - After a timeout the SynchronizedOutput render mode stays set, and DECRQM keeps
+//   reporting it as such, because only the application gets to reset it. The
+//   renderer however stops waiting and renders every frame as usual, until the
+//   application sets the mode again.
+// Arguments:
+// - <none>
+// Return Value:
+// - true if no update was in progress or if it ended in time, false if the wait timed out.
+bool Renderer::WaitForSynchronizedOutput() noexcept
+{
+    const auto beg = GetTickCount64();
+
+    while (_isSynchronizingOutput.load(std::memory_order_relaxed))
+    {
+        const auto elapsed = GetTickCount64() - beg;
+        if (elapsed >= synchronizedOutputTimeoutMilliseconds || _destructing)
+        {
+            _isSynchronizingOutput.store(false, std::memory_order_relaxed);
+            return false;
+        }
+
+        _pData->UnlockConsole();
+        til::atomic_wait(_isSynchronizingOutput, true, gsl::narrow_cast<DWORD>(synchronizedOutputTimeoutMilliseconds - elapsed));
+        _pData->LockConsole();
+    }
+
+    return true;
+}
+
 [[nodiscard]] HRESULT Renderer::_PaintFrameForEngine(_In_ IRenderEngine* const pEngine) noexcept
 try
 {
@@ -305,6 +373,43 @@ void Renderer::TriggerRedrawAll(const bool backgroundChanged, const bool frameCh
     }
 }
 
+// Routine Description:
+// - Called when the blink rendition was toggled. Only the rows within the
+//   viewport that actually contain blinking text need to be redrawn.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Renderer::TriggerRedrawBlinkingText()
+try
+{
+    const auto& buffer = _pData->GetTextBuffer();
+    const auto view = _pData->GetViewport();
+
+    const auto hasBlinkingText = [&](til::CoordType y) {
+        const auto& runs = buffer.GetRowByOffset(y).Attributes().runs();
+        return std::any_of(runs.begin(), runs.end(), [](const auto& run) { return run.value.IsBlinking(); });
+    };
+
+    // Consecutive blinking rows are coalesced into a single region.
+    for (auto y = view.Top(); y <= view.BottomInclusive(); ++y)
+    {
+        if (!hasBlinkingText(y))
+        {
+            continue;
+        }
+
+        const auto beg = y;
+        while (y < view.BottomInclusive() && hasBlinkingText(y + 1))
+        {
+            ++y;
+        }
+
+        TriggerRedraw(Viewport::FromExclusive({ view.Left(), beg, view.RightExclusive(), y + 1 }));
+    }
+}
+CATCH_LOG()
+
 // Method Description:
 // - Called when the host is about to die, to give the renderer one last chance
 //      to paint before the host exits.
@@ -330,7 +435,10 @@ try
     const auto spans = _pData->GetSelectionSpans();
     if (spans.size() != _lastSelectionPaintSize || (!spans.empty() && _lastSelectionPaintSpan != til::point_span{ spans.front().start, spans.back().end }))
     {
-        std::vector<til::rect> newSelectionViewportRects;
+        // The rects are built in a member that's swapped with _lastSelectionRectsByViewport
+        // below, so that dragging a selection around doesn't allocate on every update.
+        auto& newSelectionViewportRects = _nextSelectionRectsByViewport;
+        newSelectionViewportRects.clear();
 
         _lastSelectionPaintSize = spans.size();
         if (_lastSelectionPaintSize)
@@ -353,13 +461,46 @@ try
             }
         }
 
+        // Extending a large selection by a row shouldn't repaint every row it covers.
+        // Both lists are sorted by row and _ScrollPreviousSelection() keeps the old one
+        // relative to the current viewport, so we can walk them in lockstep and only
+        // invalidate the rows whose highlighted range actually changed.
+        auto& changedSelectionViewportRects = _changedSelectionRectsByViewport;
+        changedSelectionViewportRects.clear();
+
+        auto oldIt = _lastSelectionRectsByViewport.cbegin();
+        const auto oldEnd = _lastSelectionRectsByViewport.cend();
+        auto newIt = newSelectionViewportRects.cbegin();
+        const auto newEnd = newSelectionViewportRects.cend();
+
+        while (oldIt != oldEnd || newIt != newEnd)
+        {
+            if (newIt == newEnd || (oldIt != oldEnd && oldIt->top < newIt->top))
+            {
+                changedSelectionViewportRects.emplace_back(*oldIt++);
+            }
+            else if (oldIt == oldEnd || newIt->top < oldIt->top)
+            {
+                changedSelectionViewportRects.emplace_back(*newIt++);
+            }
+            else
+            {
+                if (*oldIt != *newIt)
+                {
+                    changedSelectionViewportRects.emplace_back(*oldIt);
+                    changedSelectionViewportRects.emplace_back(*newIt);
+                }
+                ++oldIt;
+                ++newIt;
+            }
+        }
+
         FOREACH_ENGINE(pEngine)
         {
-            LOG_IF_FAILED(pEngine->InvalidateSelection(_lastSelectionRectsByViewport));
-            LOG_IF_FAILED(pEngine->InvalidateSelection(newSelectionViewportRects));
+            LOG_IF_FAILED(pEngine->InvalidateSelection(changedSelectionViewportRects));
         }
 
-        std::exchange(_lastSelectionRectsByViewport, newSelectionViewportRects);
+        _lastSelectionRectsByViewport.swap(newSelectionViewportRects);
 
         NotifyPaintFrame();
     }
@@ -560,6 +701,24 @@ void Renderer::UpdateSoftFont(const std::span<const uint16_t> bitPattern, const
     TriggerRedrawAll();
 }
 
+// Routine Description:
+// - Called when the synchronized output mode (DECSET 2026) may have changed.
+//   While it's set, the render thread holds off on painting, in order to not
+//   present partially updated frames.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Renderer::SynchronizedOutputChanged() noexcept
+{
+    const auto enabled = _renderSettings.GetRenderMode(RenderSettings::Mode::SynchronizedOutput);
+    if (_isSynchronizingOutput.exchange(enabled, std::memory_order_relaxed) && !enabled)
+    {
+        // Wake up the render thread, if it's waiting for the update to end.
+        til::atomic_notify_all(_isSynchronizingOutput);
+    }
+}
+
 // We initially tried to have a "_isSoftFontChar" member function, but MSVC
 // failed to inline it at _all_ call sites (check invocations inside loops).
 // This issue strangely doesn't occur with static functions.
@@ -646,6 +805,38 @@ void Renderer::EnablePainting()
     }
 }
 
+// Routine Description:
+// - Lowers or restores the priority of the render thread. See RenderThread::SetLowPriority.
+// Arguments:
+// - lowPriority: true to run below normal priority, false to run at normal priority.
+// Return Value:
+// - <none>
+void Renderer::SetLowPriority(bool lowPriority) noexcept
+{
+    // When running the unit tests, we may be using a render without a render thread.
+    if (_pThread)
+    {
+        _pThread->SetLowPriority(lowPriority);
+    }
+}
+
+// Routine Description:
+// - Resets an event in the render thread that precludes it from advancing, thus disabling rendering.
+// - Unlike WaitForPaintCompletionAndDisable this doesn't wait for the current frame and
+//   is thus safe to call while holding the console lock.
+// Arguments:
+// - <none>
+// Return Value:
+// - <none>
+void Renderer::DisablePainting() noexcept
+{
+    // When running the unit tests, we may be using a render without a render thread.
+    if (_pThread)
+    {
+        _pThread->DisablePainting();
+    }
+}
+
 // Routine Description:
 // - Waits for the current paint operation to complete, if any, up to the specified timeout.
 // - Resets an event in the render thread that precludes it from advancing, thus disabling rendering.
@@ -45,6 +45,7 @@ namespace Microsoft::Console::Render
         void TriggerRedraw(const Microsoft::Console::Types::Viewport& region);
         void TriggerRedraw(const til::point* const pcoord);
         void TriggerRedrawAll(const bool backgroundChanged = false, const bool frameChanged = false);
+        void TriggerRedrawBlinkingText();
         void TriggerTeardown() noexcept;
 
         void TriggerSelection();
@@ -64,6 +65,9 @@ namespace Microsoft::Console::Render
                             const til::size cellSize,
                             const size_t centeringHint);
 
+        void SynchronizedOutputChanged() noexcept;
+        bool WaitForSynchronizedOutput() noexcept;
+
         [[nodiscard]] HRESULT GetProposedFont(const int iDpi,
                                               const FontInfoDesired& FontInfoDesired,
                                               _Out_ FontInfo& FontInfo);
@@ -71,6 +75,8 @@ namespace Microsoft::Console::Render
         bool IsGlyphWideByFont(const std::wstring_view glyph);
 
         void EnablePainting();
+        void SetLowPriority(bool lowPriority) noexcept;
+        void DisablePainting() noexcept;
         void WaitForPaintCompletionAndDisable(const DWORD dwTimeoutMs);
         void WaitUntilCanRender();
 
@@ -135,9 +141,12 @@ namespace Microsoft::Console::Render
         std::function<void()> _pfnRendererEnteredErrorState;
         bool _destructing = false;
         bool _forceUpdateViewport = false;
+        std::atomic<bool> _isSynchronizingOutput{ false };
 
         til::point_span _lastSelectionPaintSpan{};
         size_t _lastSelectionPaintSize{};
         std::vector<til::rect> _lastSelectionRectsByViewport{};
+        std::vector<til::rect> _nextSelectionRectsByViewport{};
+        std::vector<til::rect> _changedSelectionRectsByViewport{};
     };
 }
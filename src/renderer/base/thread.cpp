@@ -151,6 +151,21 @@ RenderThread::~RenderThread()
     return hr;
 }
 
+// Method Description:
+// - Lowers the priority of the render thread (or restores it) so that renderers
+//   the user isn't interacting with don't compete with the one they are.
+// Arguments:
+// - lowPriority: true to run below normal priority, false to run at normal priority.
+// Return Value:
+// - <none>
+void RenderThread::SetLowPriority(bool lowPriority) noexcept
+{
+    if (_hThread)
+    {
+        LOG_IF_WIN32_BOOL_FALSE(SetThreadPriority(_hThread, lowPriority ? THREAD_PRIORITY_BELOW_NORMAL : THREAD_PRIORITY_NORMAL));
+    }
+}
+
 DWORD WINAPI RenderThread::s_ThreadProc(_In_ LPVOID lpParameter)
 {
     const auto pContext = static_cast<RenderThread*>(lpParameter);
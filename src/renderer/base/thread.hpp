@@ -30,6 +30,7 @@ namespace Microsoft::Console::Render
         void EnablePainting() noexcept;
         void DisablePainting() noexcept;
         void WaitForPaintCompletionAndDisable(const DWORD dwTimeoutMs) noexcept;
+        void SetLowPriority(bool lowPriority) noexcept;
 
     private:
         static DWORD WINAPI s_ThreadProc(_In_ LPVOID lpParameter);
@@ -0,0 +1,51 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+#include "precomp.h"
+#include "tracing.hpp"
+
+using namespace Microsoft::Console::Render;
+
+#pragma warning(push)
+#pragma warning(disable : 26426) // Global initializer calls a non-constexpr function '...' (i.22).)
+#pragma warning(disable : 26447) // The function is declared 'noexcept' but calls function '_tlgWrapBinary<wchar_t>()' which may throw exceptions
+#pragma warning(disable : 26477) // Use 'nullptr' rather than 0 or NULL
+
+TRACELOGGING_DEFINE_PROVIDER(g_hConsoleRenderTraceProvider,
+                             "Microsoft.Windows.Console.Render",
+                             // {41a35baf-cd55-5e23-782b-7323338b5283}
+                             (0x41a35baf, 0xcd55, 0x5e23, 0x78, 0x2b, 0x73, 0x23, 0x33, 0x8b, 0x52, 0x83));
+
+static const auto cleanup = []() noexcept {
+    TraceLoggingRegister(g_hConsoleRenderTraceProvider);
+    return wil::scope_exit([]() noexcept {
+        TraceLoggingUnregister(g_hConsoleRenderTraceProvider);
+    });
+}();
+
+bool RenderTracing::IsEnabled() noexcept
+{
+    return TraceLoggingProviderEnabled(g_hConsoleRenderTraceProvider, WINEVENT_LEVEL_VERBOSE, TIL_KEYWORD_TRACE);
+}
+
+// Routine Description:
+// - Emits the timings of a single Renderer::PaintFrame() call.
+// Arguments:
+// - lockWait - How long we waited to acquire the console lock.
+// - paint - How long the engines took to paint the frame while holding the lock.
+// - present - How long the engines took to present the frame after the lock was released.
+void RenderTracing::TraceFrame(const duration lockWait, const duration paint, const duration present) noexcept
+{
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    TraceLoggingWrite(g_hConsoleRenderTraceProvider,
+                      "PaintFrame",
+                      TraceLoggingInt64(duration_cast<microseconds>(lockWait).count(), "lockWaitUs"),
+                      TraceLoggingInt64(duration_cast<microseconds>(paint).count(), "paintUs"),
+                      TraceLoggingInt64(duration_cast<microseconds>(present).count(), "presentUs"),
+                      TraceLoggingLevel(WINEVENT_LEVEL_VERBOSE),
+                      TraceLoggingKeyword(TIL_KEYWORD_TRACE));
+}
+
+#pragma warning(pop)
@@ -0,0 +1,31 @@
+// Copyright (c) Microsoft Corporation.
+// Licensed under the MIT license.
+
+/*
+Module Name:
+- tracing.hpp
+
+Abstract:
+- This module is used for recording tracing/debugging information about frame timings to the telemetry ETW channel.
+- The data is not automatically broadcast to telemetry backends.
+*/
+
+#pragma once
+
+#include <chrono>
+
+#include <winmeta.h>
+#include <TraceLoggingProvider.h>
+
+namespace Microsoft::Console::Render
+{
+    class RenderTracing sealed
+    {
+    public:
+        using duration = std::chrono::steady_clock::duration;
+
+        // Measuring the frame phases isn't free, so callers should check this first.
+        static bool IsEnabled() noexcept;
+        static void TraceFrame(duration lockWait, duration paint, duration present) noexcept;
+    };
+}
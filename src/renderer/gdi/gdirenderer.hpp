@@ -144,6 +144,12 @@ namespace Microsoft::Console::Render
         til::rect _rcInvalid;
         bool _fInvalidRectUsed;
 
+        // The rows (in pixels) that were actually invalidated within _rcInvalid.
+        // Only these are copied onto the window in EndPaint(), which matters over RDP,
+        // where every BitBlt to the window is sent to the client.
+        std::array<til::rect, 8> _rgInvalidBands{};
+        size_t _cInvalidBands = 0;
+
         COLORREF _lastFg;
         COLORREF _lastBg;
 
@@ -172,6 +178,7 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT _InvalidCombine(const til::rect* const prc) noexcept;
         [[nodiscard]] HRESULT _InvalidOffset(const til::point* const ppt) noexcept;
         [[nodiscard]] HRESULT _InvalidRestrict() noexcept;
+        void _InvalidBandCombine(til::rect band) noexcept;
 
         [[nodiscard]] HRESULT _InvalidateRect(const til::rect* const prc) noexcept;
 
@@ -118,6 +118,8 @@ HRESULT GdiEngine::_InvalidCombine(const til::rect* const prc) noexcept
         _OrRect(&_rcInvalid, prc);
     }
 
+    _InvalidBandCombine(*prc);
+
     // Ensure invalid areas remain within bounds of window.
     RETURN_IF_FAILED(_InvalidRestrict());
 
@@ -144,6 +146,17 @@ HRESULT GdiEngine::_InvalidOffset(const til::point* ppt) noexcept
         // This is the equivalent of adding in the "update rectangle" that we would get out of ScrollWindowEx/ScrollDC.
         _rcInvalid |= rcInvalidNew;
 
+        // The rows we already invalidated have moved along with the frame.
+        const auto bands = _rgInvalidBands;
+        const auto count = _cInvalidBands;
+        for (size_t i = 0; i < count; ++i)
+        {
+            auto band = til::at(bands, i);
+            band.top += ppt->y;
+            band.bottom += ppt->y;
+            _InvalidBandCombine(band);
+        }
+
         // Ensure invalid areas remain within bounds of window.
         RETURN_IF_FAILED(_InvalidRestrict());
     }
@@ -151,6 +164,51 @@ HRESULT GdiEngine::_InvalidOffset(const til::point* ppt) noexcept
     return S_OK;
 }
 
+// Routine Description:
+// - Helper to add the rows covered by the given rectangle to the list of invalid bands.
+//   Bands that overlap or touch are merged. If we run out of slots, all bands are merged
+//   into one, which is no worse than only tracking the bounding rectangle.
+// Arguments:
+// - band - Pixel region whose rows should be copied onto the window on the next frame.
+//          Only its top and bottom are used.
+// Return Value:
+// - <none>
+void GdiEngine::_InvalidBandCombine(til::rect band) noexcept
+{
+    if (band.top >= band.bottom)
+    {
+        return;
+    }
+
+    size_t count = 0;
+    for (size_t i = 0; i < _cInvalidBands; ++i)
+    {
+        const auto& existing = til::at(_rgInvalidBands, i);
+        if (existing.top <= band.bottom && band.top <= existing.bottom)
+        {
+            band.top = std::min(band.top, existing.top);
+            band.bottom = std::max(band.bottom, existing.bottom);
+        }
+        else
+        {
+            til::at(_rgInvalidBands, count++) = existing;
+        }
+    }
+
+    if (count == _rgInvalidBands.size())
+    {
+        for (const auto& existing : _rgInvalidBands)
+        {
+            band.top = std::min(band.top, existing.top);
+            band.bottom = std::max(band.bottom, existing.bottom);
+        }
+        count = 0;
+    }
+
+    til::at(_rgInvalidBands, count++) = band;
+    _cInvalidBands = count;
+}
+
 // Routine Description:
 // - Helper to ensure the invalid region remains within the bounds of the window.
 // Arguments:
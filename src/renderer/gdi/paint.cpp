@@ -224,14 +224,26 @@ bool GdiEngine::FontHasWesternScript(HDC hdc)
 
     LOG_IF_FAILED(_FlushBufferLines());
 
+    // We've repainted the entire invalid rectangle into the memory bitmap, but rows in between
+    // the ones that were actually invalidated are unchanged. Only copy those that changed.
     const auto pt = _GetInvalidRectPoint();
     const auto sz = _GetInvalidRectSize();
 
-    LOG_HR_IF(E_FAIL, !(BitBlt(_psInvalidData.hdc, pt.x, pt.y, sz.width, sz.height, _hdcMemoryContext, pt.x, pt.y, SRCCOPY)));
+    for (size_t i = 0; i < _cInvalidBands; ++i)
+    {
+        const auto& band = til::at(_rgInvalidBands, i);
+        const auto top = std::max(band.top, pt.y);
+        const auto bottom = std::min(band.bottom, pt.y + sz.height);
+        if (top < bottom)
+        {
+            LOG_HR_IF(E_FAIL, !(BitBlt(_psInvalidData.hdc, pt.x, top, sz.width, bottom - top, _hdcMemoryContext, pt.x, top, SRCCOPY)));
+        }
+    }
     WHEN_DBG(_DebugBltAll());
 
     _rcInvalid = {};
     _fInvalidRectUsed = false;
+    _cInvalidBands = 0;
     _szInvalidScroll = {};
 
     LOG_HR_IF(E_FAIL, !(GdiFlush()));
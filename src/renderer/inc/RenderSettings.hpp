@@ -25,7 +25,8 @@ namespace Microsoft::Console::Render
             AlwaysDistinguishableColors,
             IntenseIsBold,
             IntenseIsBright,
-            ScreenReversed
+            ScreenReversed,
+            SynchronizedOutput
         };
 
         RenderSettings() noexcept;
@@ -47,6 +48,16 @@ namespace Microsoft::Console::Render
         void ToggleBlinkRendition(class Renderer* renderer) noexcept;
 
     private:
+        struct PerceivableColorCacheEntry
+        {
+            COLORREF fg = 0;
+            COLORREF bg = 0;
+            COLORREF result = 0;
+        };
+        static constexpr size_t PerceivableColorCacheBits = 6;
+
+        COLORREF _getPerceivableColor(const COLORREF fg, const COLORREF bg) const noexcept;
+
         til::enumset<Mode> _renderMode{ Mode::BlinkAllowed, Mode::IntenseIsBright };
         std::array<COLORREF, TextColor::TABLE_SIZE> _colorTable;
         std::array<size_t, static_cast<size_t>(ColorAlias::ENUM_COUNT)> _colorAliasIndices;
@@ -55,5 +66,6 @@ namespace Microsoft::Console::Render
         size_t _blinkCycle = 0;
         mutable bool _blinkIsInUse = false;
         bool _blinkShouldBeFaint = false;
+        mutable std::array<PerceivableColorCacheEntry, size_t{ 1 } << PerceivableColorCacheBits> _perceivableColorCache{};
     };
 }
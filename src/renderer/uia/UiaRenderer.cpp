@@ -196,8 +196,29 @@ CATCH_LOG_RETURN_HR(E_FAIL);
     // so present can work on the copy while another
     // thread might start filling the next "frame"
     // worth of text data.
-    std::swap(_queuedOutput, _newOutput);
+    // If Present() deferred the last batch, _queuedOutput still holds its text.
+    if (_queuedOutput.empty())
+    {
+        std::swap(_queuedOutput, _newOutput);
+    }
+    else
+    {
+        try
+        {
+            _queuedOutput.append(_newOutput);
+        }
+        CATCH_LOG();
+    }
     _newOutput.clear();
+
+    // If we just fired a batch of events, hold on to this one. This needs to be decided here
+    // and not in Present(), because the renderer asks RequiresContinuousRedraw() right after.
+    const auto now = std::chrono::steady_clock::now();
+    _eventsDeferred = now - _lastEventTime < _minEventInterval;
+    if (!_eventsDeferred)
+    {
+        _lastEventTime = now;
+    }
     return S_OK;
 }
 
@@ -220,6 +241,13 @@ void UiaEngine::WaitUntilCanRender() noexcept
 {
     RETURN_HR_IF(S_FALSE, !_isEnabled);
 
+    // The flags and the queued output stay around until the next Present() that isn't deferred.
+    if (_eventsDeferred)
+    {
+        _isPainting = false;
+        return S_OK;
+    }
+
     // Fire UIA Events here
     if (_selectionChanged)
     {
@@ -268,6 +296,17 @@ void UiaEngine::WaitUntilCanRender() noexcept
     return S_OK;
 }
 
+// Routine Description:
+// - Asks the renderer to come back to us while we're holding on to deferred events.
+// Arguments:
+// - <none>
+// Return Value:
+// - True if EndPaint() deferred events that still need to be fired.
+[[nodiscard]] bool UiaEngine::RequiresContinuousRedraw() noexcept
+{
+    return _eventsDeferred;
+}
+
 // Routine Description:
 // - This is currently unused.
 // Arguments:
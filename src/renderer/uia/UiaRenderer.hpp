@@ -38,6 +38,7 @@ namespace Microsoft::Console::Render
         [[nodiscard]] HRESULT EndPaint() noexcept override;
         void WaitUntilCanRender() noexcept override;
         [[nodiscard]] HRESULT Present() noexcept override;
+        [[nodiscard]] bool RequiresContinuousRedraw() noexcept override;
         [[nodiscard]] HRESULT ScrollFrame() noexcept override;
         [[nodiscard]] HRESULT Invalidate(const til::rect* const psrRegion) noexcept override;
         [[nodiscard]] HRESULT InvalidateCursor(const til::rect* const psrRegion) noexcept override;
@@ -72,6 +73,13 @@ namespace Microsoft::Console::Render
         std::wstring _newOutput;
         std::wstring _queuedOutput;
 
+        // Automation clients like Narrator can't keep up with an event (or three) per
+        // frame during heavy output. Bursts of frames are coalesced by holding on to
+        // the pending events until at least this much time passed since the last batch.
+        static constexpr std::chrono::milliseconds _minEventInterval{ 50 };
+        std::chrono::steady_clock::time_point _lastEventTime{};
+        bool _eventsDeferred = false;
+
         Microsoft::Console::Types::IUiaEventDispatcher* _dispatcher;
 
         til::rect _prevCursorRegion;
@@ -203,7 +203,24 @@ CATCH_RETURN()
 try
 {
     RETURN_LAST_ERROR_IF(_hWddmConCtx == INVALID_HANDLE_VALUE);
-    return WDDMConEndUpdateDisplayBatch(_hWddmConCtx);
+
+    // PaintBufferLine() is called once per run of equally attributed cells, which means that a single
+    // row may receive many calls. Instead of submitting the row each time, we submit each row once here.
+    // Since the Old state still holds the previous frame (see PaintBackground), WDDMCon can diff it.
+    // The batch opened by StartPaint() must be closed even if a row fails, so we return the first error afterwards.
+    auto hr = S_OK;
+    for (LONG rowIndex = 0; rowIndex < _displayHeight; rowIndex++)
+    {
+        const auto hrRow = WDDMConUpdateDisplay(_hWddmConCtx, _displayState[rowIndex], FALSE);
+        if (FAILED(hrRow) && SUCCEEDED(hr))
+        {
+            hr = hrRow;
+        }
+    }
+
+    const auto hrEnd = WDDMConEndUpdateDisplayBatch(_hWddmConCtx);
+    RETURN_IF_FAILED(hr);
+    return hrEnd;
 }
 CATCH_RETURN()
 
@@ -256,19 +273,16 @@ CATCH_RETURN()
     {
         RETURN_LAST_ERROR_IF(_hWddmConCtx == INVALID_HANDLE_VALUE);
 
+        // The Old state was already updated by PaintBackground() and the row gets submitted in EndPaint().
         for (size_t i = 0; i < clusters.size() && i < gsl::narrow_cast<size_t>(_displayWidth); i++)
         {
-            const auto OldChar = &_displayState[coord.y]->Old[coord.x + i];
             const auto NewChar = &_displayState[coord.y]->New[coord.x + i];
 
-            OldChar->Character = NewChar->Character;
-            OldChar->Attribute = NewChar->Attribute;
-
             NewChar->Character = til::at(clusters, i).GetTextAsSingle();
             NewChar->Attribute = _currentLegacyColorAttribute;
         }
 
-        return WDDMConUpdateDisplay(_hWddmConCtx, _displayState[coord.y], FALSE);
+        return S_OK;
     }
     CATCH_RETURN();
 }
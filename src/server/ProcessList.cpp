@@ -41,6 +41,15 @@ using namespace Microsoft::Console::Interactivity;
     {
         pProcessData = std::make_unique<ConsoleProcessHandle>(dwProcessId, dwThreadId, ulProcessGroupId);
         _processes.emplace_back(pProcessData.get());
+        try
+        {
+            _processesById.emplace(dwProcessId, pProcessData.get());
+        }
+        catch (...)
+        {
+            _processes.pop_back();
+            throw;
+        }
     }
     CATCH_RETURN();
 
@@ -63,6 +72,7 @@ void ConsoleProcessList::FreeProcessData(_In_ ConsoleProcessHandle* const pProce
     if (it != _processes.end())
     {
         _processes.erase(it);
+        _processesById.erase(pProcessData->dwProcessId);
         delete pProcessData;
     }
     else
@@ -84,15 +94,8 @@ ConsoleProcessHandle* ConsoleProcessList::FindProcessInList(const DWORD dwProces
 {
     assert(ServiceLocator::LocateGlobals().getConsoleInformation().IsConsoleLocked());
 
-    for (const auto& p : _processes)
-    {
-        if (p->dwProcessId == dwProcessId)
-        {
-            return p;
-        }
-    }
-
-    return nullptr;
+    const auto it = _processesById.find(dwProcessId);
+    return it != _processesById.end() ? it->second : nullptr;
 }
 
 // Routine Description:
@@ -58,7 +58,10 @@ public:
     bool IsEmpty() const;
 
 private:
+    // _processes is ordered from oldest to newest, which GetProcessList and GetOldestProcess rely on.
+    // _processesById indexes the same handles by PID, because every connect checks for duplicates.
     std::vector<ConsoleProcessHandle*> _processes;
+    std::unordered_map<DWORD, ConsoleProcessHandle*> _processesById;
 
     void _ModifyProcessForegroundRights(const HANDLE hProcess, const bool fForeground) const;
 };
@@ -171,12 +171,11 @@ void PageManager::MoveTo(const til::CoordType pageNumber, const bool makeVisible
     {
         const auto& newBuffer = _getBuffer(newPageNumber, pageSize);
         auto& saveBuffer = _getBuffer(_visiblePageNumber, pageSize);
+        // The save and new buffers are always distinct, so both copies can
+        // be done in a single pass while the visible row is still in cache.
         for (auto i = 0; i < pageSize.height; i++)
         {
             visibleBuffer.CopyRow(visibleTop + i, i, saveBuffer);
-        }
-        for (auto i = 0; i < pageSize.height; i++)
-        {
             newBuffer.CopyRow(i, visibleTop + i, visibleBuffer);
         }
         _visiblePageNumber = newPageNumber;
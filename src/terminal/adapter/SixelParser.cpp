@@ -690,7 +690,9 @@ void SixelParser::_writeToImageBuffer(int sixelValue, int repeatCount)
     const auto targetOffset = _imageCursor.y * _imageMaxWidth + _imageCursor.x;
     auto imageBufferPtr = std::next(_imageBuffer.data(), targetOffset);
     repeatCount = std::min(repeatCount, _imageMaxWidth - _imageCursor.x);
-    for (auto i = 0; i < 6; i++)
+    // The sixel value only has 6 bits, so we can stop as soon as the remaining
+    // bits are all zero and skip the rows that wouldn't be drawn anyway.
+    while (sixelValue != 0)
     {
         if (sixelValue & 1)
         {
@@ -779,6 +781,11 @@ void SixelParser::_maybeFlushImageBuffer(const bool endOfSequence)
         // so the only visible change will be the scrolling.
         if (_imageWidth > 0)
         {
+            // Converting the color table upfront is a lot cheaper than doing
+            // it for every pixel, given that images have far more pixels than colors.
+            std::array<RGBQUAD, MAX_COLORS> palette;
+            std::transform(_colorTable.begin(), _colorTable.end(), palette.begin(), _makeRGBQUAD);
+
             const auto columnBegin = _imageOriginCell.x;
             const auto columnEnd = _imageOriginCell.x + (_imageWidth + _cellSize.width - 1) / _cellSize.width;
             auto rowOffset = _imageOriginCell.y;
@@ -802,8 +809,7 @@ void SixelParser::_maybeFlushImageBuffer(const bool endOfSequence)
                             const auto srcPixel = til::at(srcIterator, pixelColumn);
                             if (!srcPixel.transparent)
                             {
-                                const auto srcColor = _colorFromIndex(srcPixel.colorIndex);
-                                til::at(dstIterator, pixelColumn) = _makeRGBQUAD(srcColor);
+                                til::at(dstIterator, pixelColumn) = til::at(palette, srcPixel.colorIndex);
                             }
                         }
                         std::advance(srcIterator, _imageMaxWidth);
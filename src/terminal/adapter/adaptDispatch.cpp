@@ -598,20 +598,15 @@ void AdaptDispatch::_ScrollRectVertically(const Page& page, const til::rect& scr
         else
         {
             // Otherwise we have to move the content up or down by copying the
-            // requested buffer range one cell at a time.
-            const auto srcOrigin = til::point{ scrollRect.left, top };
-            const auto dstOrigin = til::point{ scrollRect.left, top + actualDelta };
-            const auto srcView = Viewport::FromDimensions(srcOrigin, { width, height });
-            const auto dstView = Viewport::FromDimensions(dstOrigin, { width, height });
-            const auto walkDirection = Viewport::DetermineWalkDirection(srcView, dstView);
-            auto srcPos = srcView.GetWalkOrigin(walkDirection);
-            auto dstPos = dstView.GetWalkOrigin(walkDirection);
-            do
+            // requested buffer range one row segment at a time. When moving down
+            // we start at the bottom, so that we don't overwrite rows not yet copied.
+            const auto srcView = Viewport::FromDimensions({ scrollRect.left, top }, { width, height });
+            const auto dstView = Viewport::Offset(srcView, { 0, actualDelta });
+            for (auto i = 0; i < height; i++)
             {
-                const auto current = OutputCell(*textBuffer.GetCellDataAt(srcPos));
-                textBuffer.WriteLine(OutputCellIterator({ &current, 1 }), dstPos);
-                srcView.WalkInBounds(srcPos, walkDirection);
-            } while (dstView.WalkInBounds(dstPos, walkDirection));
+                const auto y = actualDelta > 0 ? top + height - 1 - i : top + i;
+                textBuffer.CopyRowSegment(y, scrollRect.left, y + actualDelta, scrollRect.left, width);
+            }
             // Copy any image content in the affected area.
             ImageSlice::CopyBlock(textBuffer, srcView.ToExclusive(), textBuffer, dstView.ToExclusive());
         }
@@ -650,20 +645,13 @@ void AdaptDispatch::_ScrollRectHorizontally(const Page& page, const til::rect& s
 
         const auto source = Viewport::FromDimensions({ left, top }, { width, height });
         const auto target = Viewport::Offset(source, { actualDelta, 0 });
-        const auto walkDirection = Viewport::DetermineWalkDirection(source, target);
-        auto sourcePos = source.GetWalkOrigin(walkDirection);
-        auto targetPos = target.GetWalkOrigin(walkDirection);
-        // Note that we read two cells from the source before we start writing
-        // to the target, so a two-cell DBCS character can't accidentally delete
-        // itself when moving one cell horizontally.
-        auto next = OutputCell(*textBuffer.GetCellDataAt(sourcePos));
-        do
+        // CopyRowSegment() backs up the row before it shifts the segment, so
+        // a two-cell DBCS character can't accidentally delete itself when
+        // moving one cell horizontally.
+        for (auto y = source.Top(); y < source.BottomExclusive(); y++)
         {
-            const auto current = next;
-            source.WalkInBounds(sourcePos, walkDirection);
-            next = OutputCell(*textBuffer.GetCellDataAt(sourcePos));
-            textBuffer.WriteLine(OutputCellIterator({ &current, 1 }), targetPos);
-        } while (target.WalkInBounds(targetPos, walkDirection));
+            textBuffer.CopyRowSegment(y, left, y, left + actualDelta, width);
+        }
         // Copy any image content in the affected area.
         ImageSlice::CopyBlock(textBuffer, source.ToExclusive(), textBuffer, target.ToExclusive());
     }
@@ -1340,10 +1328,37 @@ void AdaptDispatch::RequestChecksumRectangularArea(const VTInt id, const VTInt p
                 defaultFgIndex = defaultFgIndex < 16 ? defaultFgIndex : 7;
                 defaultBgIndex = defaultBgIndex < 16 ? defaultBgIndex : 0;
 
+                // Since we're attempting to match the DEC checksum algorithm,
+                // the only attributes affecting the checksum are the ones that
+                // were supported by DEC terminals.
+                const auto attributeWeight = [&](const TextAttribute& attr) {
+                    uint16_t weight = 0;
+                    weight += attr.IsProtected() ? 0x04 : 0;
+                    weight += attr.IsInvisible() ? 0x08 : 0;
+                    weight += attr.IsUnderlined() ? 0x10 : 0;
+                    weight += attr.IsReverseVideo() ? 0x20 : 0;
+                    weight += attr.IsBlinking() ? 0x40 : 0;
+                    weight += attr.IsIntense() ? 0x80 : 0;
+
+                    // For the same reason, we only care about the eight basic ANSI
+                    // colors, although technically we also report the 8-16 index
+                    // range. Everything else gets mapped to the default colors.
+                    const auto colorIndex = [](const auto color, const auto defaultIndex) {
+                        return color.IsLegacy() ? color.GetIndex() : defaultIndex;
+                    };
+                    const auto fgIndex = colorIndex(attr.GetForeground(), defaultFgIndex);
+                    const auto bgIndex = colorIndex(attr.GetBackground(), defaultBgIndex);
+                    weight += gsl::narrow_cast<uint16_t>(fgIndex << 4);
+                    weight += gsl::narrow_cast<uint16_t>(bgIndex);
+                    return weight;
+                };
+
                 const auto target = _pages.Get(page);
                 const auto eraseRect = _CalculateRectArea(target, top, left, bottom, right);
                 for (auto row = eraseRect.top; row < eraseRect.bottom; row++)
                 {
+                    const auto& rowRef = target.Buffer().GetRowByOffset(row);
+
                     for (auto col = eraseRect.left; col < eraseRect.right; col++)
                     {
                         // The algorithm we're using here should match the DEC terminals
@@ -1351,35 +1366,30 @@ void AdaptDispatch::RequestChecksumRectangularArea(const VTInt id, const VTInt p
                         // predate Unicode, though, so we'd need a custom mapping table
                         // to lookup the correct checksums. Considering this is only for
                         // testing at the moment, that doesn't seem worth the effort.
-                        const auto cell = target.Buffer().GetCellDataAt({ col, row });
-                        for (auto ch : cell->Chars())
+                        for (auto ch : rowRef.GlyphAt(col))
                         {
                             // That said, I've made a special allowance for U+2426,
                             // since that is widely used in a lot of character sets.
                             checksum -= (ch == L'\u2426' ? 0x1B : ch);
                         }
+                    }
 
-                        // Since we're attempting to match the DEC checksum algorithm,
-                        // the only attributes affecting the checksum are the ones that
-                        // were supported by DEC terminals.
-                        const auto attr = cell->TextAttr();
-                        checksum -= attr.IsProtected() ? 0x04 : 0;
-                        checksum -= attr.IsInvisible() ? 0x08 : 0;
-                        checksum -= attr.IsUnderlined() ? 0x10 : 0;
-                        checksum -= attr.IsReverseVideo() ? 0x20 : 0;
-                        checksum -= attr.IsBlinking() ? 0x40 : 0;
-                        checksum -= attr.IsIntense() ? 0x80 : 0;
-
-                        // For the same reason, we only care about the eight basic ANSI
-                        // colors, although technically we also report the 8-16 index
-                        // range. Everything else gets mapped to the default colors.
-                        const auto colorIndex = [](const auto color, const auto defaultIndex) {
-                            return color.IsLegacy() ? color.GetIndex() : defaultIndex;
-                        };
-                        const auto fgIndex = colorIndex(attr.GetForeground(), defaultFgIndex);
-                        const auto bgIndex = colorIndex(attr.GetBackground(), defaultBgIndex);
-                        checksum -= gsl::narrow_cast<uint16_t>(fgIndex << 4);
-                        checksum -= gsl::narrow_cast<uint16_t>(bgIndex);
+                    // The attributes are run-length encoded, so we only need
+                    // to compute their weight once per run, not once per cell.
+                    til::CoordType runBeg = 0;
+                    for (const auto& run : rowRef.Attributes().runs())
+                    {
+                        const auto runEnd = runBeg + run.length;
+                        const auto overlap = std::min(runEnd, eraseRect.right) - std::max(runBeg, eraseRect.left);
+                        if (overlap > 0)
+                        {
+                            checksum -= gsl::narrow_cast<uint16_t>(attributeWeight(run.value) * overlap);
+                        }
+                        if (runEnd >= eraseRect.right)
+                        {
+                            break;
+                        }
+                        runBeg = runEnd;
                     }
                 }
             }
@@ -1914,6 +1924,13 @@ void AdaptDispatch::_ModeParamsHelper(const DispatchTypes::ModeParams param, con
     case DispatchTypes::ModeParams::XTERM_BracketedPasteMode:
         _api.SetSystemMode(ITerminalApi::Mode::BracketedPaste, enable);
         break;
+    case DispatchTypes::ModeParams::SO_SynchronizedOutput:
+        _renderSettings.SetRenderMode(RenderSettings::Mode::SynchronizedOutput, enable);
+        if (_renderer)
+        {
+            _renderer->SynchronizedOutputChanged();
+        }
+        break;
     case DispatchTypes::ModeParams::GCM_GraphemeClusterMode:
         break;
     case DispatchTypes::ModeParams::W32IM_Win32InputMode:
@@ -2052,6 +2069,9 @@ void AdaptDispatch::RequestMode(const DispatchTypes::ModeParams param)
     case DispatchTypes::ModeParams::XTERM_BracketedPasteMode:
         state = mapTemp(_api.GetSystemMode(ITerminalApi::Mode::BracketedPaste));
         break;
+    case DispatchTypes::ModeParams::SO_SynchronizedOutput:
+        state = mapTemp(_renderSettings.GetRenderMode(RenderSettings::Mode::SynchronizedOutput));
+        break;
     case DispatchTypes::ModeParams::GCM_GraphemeClusterMode:
         state = mapPerm(CodepointWidthDetector::Singleton().GetMode() == TextMeasurementMode::Graphemes);
         break;
@@ -3033,9 +3053,11 @@ void AdaptDispatch::HardReset()
 
     // Set the color table and render modes back to their initial startup values.
     _renderSettings.RestoreDefaultSettings();
-    // Let the renderer know that the background and frame colors may have changed.
+    // Let the renderer know that the background and frame colors may have changed,
+    // and that any synchronized update in progress has been cancelled.
     if (_renderer)
     {
+        _renderer->SynchronizedOutputChanged();
         _renderer->TriggerRedrawAll(true, true);
     }
 
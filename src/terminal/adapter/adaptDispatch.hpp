@@ -30,7 +30,7 @@ class AdapterTest;
 
 namespace Microsoft::Console::VirtualTerminal
 {
-    class AdaptDispatch : public ITermDispatch
+    class AdaptDispatch final : public ITermDispatch
     {
         using Renderer = Microsoft::Console::Render::Renderer;
         using RenderSettings = Microsoft::Console::Render::RenderSettings;
@@ -152,7 +152,7 @@ namespace Microsoft::Console::VirtualTerminal
         SS3_F4 = L'S',
     };
 
-    class InputStateMachineEngine : public IStateMachineEngine
+    class InputStateMachineEngine final : public IStateMachineEngine
     {
     public:
         InputStateMachineEngine(std::unique_ptr<IInteractDispatch> pDispatch, const bool lookingForDSR = false);
@@ -17,7 +17,7 @@ Abstract:
 
 namespace Microsoft::Console::VirtualTerminal
 {
-    class OutputStateMachineEngine : public IStateMachineEngine
+    class OutputStateMachineEngine final : public IStateMachineEngine
     {
     public:
         static constexpr size_t MAX_URL_LENGTH = 2 * 1048576; // 2MB, like iTerm2
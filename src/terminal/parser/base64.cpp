@@ -85,6 +85,93 @@ HRESULT Base64::Decode(const std::wstring_view& src, std::wstring& dst) noexcept
         r = r << 6 | n;
     };
 
+    // This vectorized loop decodes 16 characters into 12 bytes at a time. It stops as soon as
+    // a block contains anything outside the base64 alphabet (like the trailing "=" or invalid input)
+    // and leaves the rest to the scalar code below, which also takes care of reporting errors.
+    // Since it only ever consumes full groups of 4 characters, `r` doesn't need to be carried over.
+#if defined(TIL_SSE_INTRINSICS)
+    while (inEnd - in >= 16)
+    {
+        // _mm_packus_epi16 treats its inputs as signed 16-bit values and saturates them to unsigned 8-bit:
+        // 0x100-0x7fff turn into 0xff, while 0x8000-0xffff are negative and turn into 0x00. Neither 0x00 nor
+        // anything >0x7f (negative when interpreted as signed chars) matches any of the ranges below (= invalid).
+        const auto ch = _mm_packus_epi16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(in)), _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 8)));
+        const auto upper = _mm_and_si128(_mm_cmpgt_epi8(ch, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(ch, _mm_set1_epi8('Z' + 1)));
+        const auto lower = _mm_and_si128(_mm_cmpgt_epi8(ch, _mm_set1_epi8('a' - 1)), _mm_cmplt_epi8(ch, _mm_set1_epi8('z' + 1)));
+        const auto digit = _mm_and_si128(_mm_cmpgt_epi8(ch, _mm_set1_epi8('0' - 1)), _mm_cmplt_epi8(ch, _mm_set1_epi8('9' + 1)));
+        const auto is62 = _mm_or_si128(_mm_cmpeq_epi8(ch, _mm_set1_epi8('+')), _mm_cmpeq_epi8(ch, _mm_set1_epi8('-')));
+        const auto is63 = _mm_or_si128(_mm_cmpeq_epi8(ch, _mm_set1_epi8('/')), _mm_cmpeq_epi8(ch, _mm_set1_epi8('_')));
+        const auto valid = _mm_or_si128(_mm_or_si128(upper, lower), _mm_or_si128(digit, _mm_or_si128(is62, is63)));
+
+        if (_mm_movemask_epi8(valid) != 0xffff)
+        {
+            break;
+        }
+
+        auto n = _mm_and_si128(upper, _mm_sub_epi8(ch, _mm_set1_epi8('A')));
+        n = _mm_or_si128(n, _mm_and_si128(lower, _mm_sub_epi8(ch, _mm_set1_epi8('a' - 26))));
+        n = _mm_or_si128(n, _mm_and_si128(digit, _mm_add_epi8(ch, _mm_set1_epi8(52 - '0'))));
+        n = _mm_or_si128(n, _mm_and_si128(is62, _mm_set1_epi8(62)));
+        n = _mm_or_si128(n, _mm_and_si128(is63, _mm_set1_epi8(63)));
+
+        // Merge pairs of 6-bit values into 12 bits per 16-bit lane and those into 24 bits per 32-bit lane.
+        const auto pairs = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(n, _mm_set1_epi16(0xff)), 6), _mm_srli_epi16(n, 8));
+        const auto quads = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(pairs, _mm_set1_epi32(0xffff)), 12), _mm_srli_epi32(pairs, 16));
+
+        alignas(16) uint32_t q[4];
+        _mm_store_si128(reinterpret_cast<__m128i*>(&q[0]), quads);
+
+        for (const auto v : q)
+        {
+            *out++ = gsl::narrow_cast<char>(v >> 16);
+            *out++ = gsl::narrow_cast<char>(v >> 8);
+            *out++ = gsl::narrow_cast<char>(v >> 0);
+        }
+
+        in += 16;
+    }
+#elif defined(TIL_ARM_NEON_INTRINSICS)
+    while (inEnd - in >= 16)
+    {
+        // Characters >0xff get saturated to 0xff, which like all others >0x7f won't match any of the ranges below.
+        const auto ch = vcombine_u8(vqmovn_u16(vld1q_u16(reinterpret_cast<const uint16_t*>(in))), vqmovn_u16(vld1q_u16(reinterpret_cast<const uint16_t*>(in + 8))));
+        const auto upper = vandq_u8(vcgeq_u8(ch, vdupq_n_u8('A')), vcleq_u8(ch, vdupq_n_u8('Z')));
+        const auto lower = vandq_u8(vcgeq_u8(ch, vdupq_n_u8('a')), vcleq_u8(ch, vdupq_n_u8('z')));
+        const auto digit = vandq_u8(vcgeq_u8(ch, vdupq_n_u8('0')), vcleq_u8(ch, vdupq_n_u8('9')));
+        const auto is62 = vorrq_u8(vceqq_u8(ch, vdupq_n_u8('+')), vceqq_u8(ch, vdupq_n_u8('-')));
+        const auto is63 = vorrq_u8(vceqq_u8(ch, vdupq_n_u8('/')), vceqq_u8(ch, vdupq_n_u8('_')));
+        const auto valid = vorrq_u8(vorrq_u8(upper, lower), vorrq_u8(digit, vorrq_u8(is62, is63)));
+
+        if (vminvq_u8(valid) == 0)
+        {
+            break;
+        }
+
+        auto n = vandq_u8(upper, vsubq_u8(ch, vdupq_n_u8('A')));
+        n = vorrq_u8(n, vandq_u8(lower, vsubq_u8(ch, vdupq_n_u8('a' - 26))));
+        n = vorrq_u8(n, vandq_u8(digit, vaddq_u8(ch, vdupq_n_u8(52 - '0'))));
+        n = vorrq_u8(n, vandq_u8(is62, vdupq_n_u8(62)));
+        n = vorrq_u8(n, vandq_u8(is63, vdupq_n_u8(63)));
+
+        // Merge pairs of 6-bit values into 12 bits per 16-bit lane and those into 24 bits per 32-bit lane.
+        const auto n16 = vreinterpretq_u16_u8(n);
+        const auto pairs = vreinterpretq_u32_u16(vorrq_u16(vshlq_n_u16(vandq_u16(n16, vdupq_n_u16(0xff)), 6), vshrq_n_u16(n16, 8)));
+        const auto quads = vorrq_u32(vshlq_n_u32(vandq_u32(pairs, vdupq_n_u32(0xffff)), 12), vshrq_n_u32(pairs, 16));
+
+        uint32_t q[4];
+        vst1q_u32(&q[0], quads);
+
+        for (const auto v : q)
+        {
+            *out++ = gsl::narrow_cast<char>(v >> 16);
+            *out++ = gsl::narrow_cast<char>(v >> 8);
+            *out++ = gsl::narrow_cast<char>(v >> 0);
+        }
+
+        in += 16;
+    }
+#endif
+
     // If src.empty() then `in == inEndBatched == nullptr` and this is skipped.
     while (in < inEndBatched)
     {
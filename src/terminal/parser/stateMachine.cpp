@@ -372,6 +372,43 @@ static constexpr bool _isApcIndicator(const wchar_t wch) noexcept
     return wch == L'_'; // 0x5F
 }
 
+// The classes of characters that make up the parameter portion of a control sequence.
+// See _ProcessCsiParameterRun for how they're used.
+enum class CsiParameterClass : uint8_t
+{
+    None,
+    Digit,
+    ParameterDelimiter,
+    SubParameterDelimiter,
+};
+
+// A lookup table for the ASCII range, generated at compile-time from the predicates above.
+// It's used to classify parameter characters with a single load instead of a chain of comparisons.
+static constexpr auto csiParameterClasses = []() {
+    std::array<CsiParameterClass, 128> classes{};
+    for (wchar_t wch = 0; wch < classes.size(); ++wch)
+    {
+        if (_isNumericParamValue(wch))
+        {
+            til::at(classes, wch) = CsiParameterClass::Digit;
+        }
+        else if (_isParameterDelimiter(wch))
+        {
+            til::at(classes, wch) = CsiParameterClass::ParameterDelimiter;
+        }
+        else if (_isSubParameterDelimiter(wch))
+        {
+            til::at(classes, wch) = CsiParameterClass::SubParameterDelimiter;
+        }
+    }
+    return classes;
+}();
+
+static constexpr CsiParameterClass _classifyCsiParameter(const wchar_t wch) noexcept
+{
+    return wch < csiParameterClasses.size() ? til::at(csiParameterClasses, wch) : CsiParameterClass::None;
+}
+
 #pragma warning(pop)
 
 // Routine Description:
@@ -603,6 +640,134 @@ void StateMachine::_ActionSubParam(const wchar_t wch)
     }
 }
 
+// Routine Description:
+// - A fast path for the parameter portion of a control sequence, for instance
+//   the "38;2;255;128;0" in an SGR sequence. It's only called while we're in the
+//   CsiEntry, CsiParam or CsiSubParam state and consumes as many digits and
+//   delimiters as possible, with the exact same semantics as the corresponding
+//   _EventCsi* handlers. Runs of digits are accumulated into a local value and
+//   stored only once, instead of going through ProcessCharacter one at a time.
+// Arguments:
+// - string - The remaining characters of the current string.
+// Return Value:
+// - The number of characters that were consumed.
+#pragma warning(push)
+#pragma warning(disable : 26481) // Don't use pointer arithmetic. Use span instead (bounds.1).
+size_t StateMachine::_ProcessCsiParameterRun(const std::wstring_view string)
+{
+    const auto beg = string.data();
+    const auto end = beg + string.size();
+    auto it = beg;
+
+    while (it != end)
+    {
+        const auto parameterClass = _classifyCsiParameter(*it);
+        if (parameterClass == CsiParameterClass::None)
+        {
+            break;
+        }
+
+        switch (parameterClass)
+        {
+        case CsiParameterClass::Digit:
+        {
+            const auto digitsEnd = std::find_if_not(it, end, _isNumericParamValue);
+
+            if (_state == VTStates::CsiSubParam)
+            {
+                if (!_subParameterLimitOverflowed)
+                {
+                    auto value = _subParameters.back().value_or(0);
+                    for (; it != digitsEnd; ++it)
+                    {
+                        _AccumulateTo(*it, value);
+                    }
+                    _subParameters.back() = value;
+                }
+            }
+            else
+            {
+                if (!_parameterLimitOverflowed)
+                {
+                    if (_parameters.empty())
+                    {
+                        _parameters.push_back({});
+                        const auto rangeStart = gsl::narrow_cast<BYTE>(_subParameters.size());
+                        _subParameterRanges.push_back({ rangeStart, rangeStart });
+                    }
+
+                    auto value = _parameters.back().value_or(0);
+                    for (; it != digitsEnd; ++it)
+                    {
+                        _AccumulateTo(*it, value);
+                    }
+                    _parameters.back() = value;
+                }
+
+                if (_state == VTStates::CsiEntry)
+                {
+                    _EnterCsiParam();
+                }
+            }
+
+            it = digitsEnd;
+            break;
+        }
+        case CsiParameterClass::ParameterDelimiter:
+            _ActionParam(*it);
+            if (_state != VTStates::CsiParam)
+            {
+                _EnterCsiParam();
+            }
+            ++it;
+            break;
+        case CsiParameterClass::SubParameterDelimiter:
+            _ActionSubParam(*it);
+            if (_state != VTStates::CsiSubParam)
+            {
+                _EnterCsiSubParam();
+            }
+            ++it;
+            break;
+        default:
+            break;
+        }
+    }
+
+    const auto consumed = gsl::narrow_cast<size_t>(it - beg);
+    _trace.AddSequenceTrace(std::wstring_view{ beg, consumed });
+    return consumed;
+}
+#pragma warning(pop)
+
+// Routine Description:
+// - A fast path for the payload of an OSC string, for instance the base64 data of
+//   an OSC 52 clipboard write. It's only called while we're in the OscString state and
+//   appends the entire run of non-control characters to _oscString at once, with the exact
+//   same semantics as _EventOscString. Any C0 or C1 control character ends the run
+//   and is left for ProcessCharacter to handle.
+// Arguments:
+// - string - The remaining characters of the current string.
+// Return Value:
+// - The number of characters that were consumed.
+size_t StateMachine::_ProcessOscStringRun(const std::wstring_view string)
+{
+    const auto end = std::find_if(string.begin(), string.end(), [](const auto wch) {
+        return wch < L' ' || _isC1ControlCharacter(wch);
+    });
+    const auto consumed = gsl::narrow_cast<size_t>(end - string.begin());
+
+    if (consumed)
+    {
+        const auto run = string.substr(0, consumed);
+        _trace.AddSequenceTrace(run);
+        _trace.TraceOnAction(L"OscPut");
+        _oscString.append(run);
+    }
+
+    return consumed;
+}
+
 // Routine Description:
 // - Triggers the Clear action to indicate that the state machine should erase all internal state.
 // Arguments:
@@ -2018,6 +2183,28 @@ void StateMachine::ProcessString(const std::wstring_view string)
 
         do
         {
+            // Parameters make up the bulk of most control sequences (think SGR-heavy TUIs)
+            // and OSC payloads can be huge (think OSC 52 clipboard writes), so we consume
+            // them in bulk, instead of passing them to ProcessCharacter one by one.
+            size_t consumed = 0;
+            if (_state == VTStates::CsiEntry || _state == VTStates::CsiParam || _state == VTStates::CsiSubParam)
+            {
+                consumed = _ProcessCsiParameterRun(string.substr(i));
+            }
+            else if (_state == VTStates::OscString)
+            {
+                consumed = _ProcessOscStringRun(string.substr(i));
+            }
+            if (consumed)
+            {
+                _runSize += consumed;
+                i += consumed;
+                if (i >= string.size())
+                {
+                    break;
+                }
+            }
+
             _runSize++;
             _processingLastCharacter = i + 1 >= string.size();
             // If we're processing characters individually, send it to the state machine.
@@ -157,6 +157,8 @@ namespace Microsoft::Console::VirtualTerminal
         void _EventSosPmApcString(const wchar_t wch) noexcept;
 
         void _AccumulateTo(const wchar_t wch, VTInt& value) noexcept;
+        size_t _ProcessCsiParameterRun(const std::wstring_view string);
+        size_t _ProcessOscStringRun(const std::wstring_view string);
 
         template<typename TLambda>
         bool _SafeExecute(TLambda&& lambda);
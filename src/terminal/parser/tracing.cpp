@@ -93,6 +93,14 @@ void ParserTracing::AddSequenceTrace(const wchar_t wch)
     }
 }
 
+void ParserTracing::AddSequenceTrace(const std::wstring_view string)
+{
+    if (!string.empty() && TraceLoggingProviderEnabled(g_hConsoleVirtTermParserEventTraceProvider, WINEVENT_LEVEL_VERBOSE, TIL_KEYWORD_TRACE))
+    {
+        _sequenceTrace.append(string);
+    }
+}
+
 void ParserTracing::DispatchSequenceTrace(const bool fSuccess) noexcept
 {
     if (fSuccess)
@@ -117,4 +117,18 @@ class Microsoft::Console::VirtualTerminal::Base64Test
         Base64::Decode(L"8J+RjfCfkY3wn4+78J+RjfCfj7zwn5GN8J+PvfCfkY3wn4++8J+RjfCfj78=", result);
         VERIFY_ARE_EQUAL(L"👍👍🏻👍🏼👍🏽👍🏾👍🏿", result);
     }
+
+    TEST_METHOD(DecodeInvalid)
+    {
+        std::wstring result;
+
+        // Invalid characters must be detected no matter whether they're
+        // part of a large block of input or in the tail end of the string.
+        VERIFY_ARE_EQUAL(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), Base64::Decode(L"SGVsbG8s!FdvcmxkIQ==", result));
+        VERIFY_ARE_EQUAL(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), Base64::Decode(L"SGV\u00e9bG8sIFdvcmxkIQ==", result));
+        VERIFY_ARE_EQUAL(HRESULT_FROM_WIN32(ERROR_INVALID_DATA), Base64::Decode(L"SGVsbG8sIFdvcmxkI!==", result));
+
+        VERIFY_SUCCEEDED(Base64::Decode(L"SGVsbG8sIFdvcmxkIQ==", result));
+        VERIFY_ARE_EQUAL(L"Hello, World!", result);
+    }
 };
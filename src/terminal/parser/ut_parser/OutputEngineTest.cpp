@@ -3261,6 +3261,18 @@ class StateMachineExternalTest final
         VERIFY_IS_TRUE(pDispatch->_setWindowTitle);
         VERIFY_ARE_EQUAL(L"", pDispatch->_setWindowTitleText);
 
+        pDispatch->ClearState();
+        pDispatch->_setWindowTitleText = L"****"; // Make sure this is cleared
+
+        // Invalid control characters in the middle of the string are ignored,
+        // and strings broken up across multiple writes are joined together.
+        mach.ProcessString(oscPrefix);
+        mach.ProcessString(L";Title\x01 Te");
+        mach.ProcessString(L"xt");
+        mach.ProcessString(stringTerminator);
+        VERIFY_IS_TRUE(pDispatch->_setWindowTitle);
+        VERIFY_ARE_EQUAL(L"Title Text", pDispatch->_setWindowTitleText);
+
         pDispatch->ClearState();
     }
 
@@ -158,6 +158,10 @@ class Microsoft::Console::VirtualTerminal::StateMachineTest
     TEST_METHOD(DcsDataStringsReceivedByHandler);
 
     TEST_METHOD(VtParameterSubspanTest);
+
+    TEST_METHOD(CsiParametersSplitAtEveryPosition);
+    TEST_METHOD(SgrParsingPerformance);
+    TEST_METHOD(ParsingThroughputPerClass);
 };
 
 void StateMachineTest::TwoStateMachinesDoNotInterfereWithEachOther()
@@ -373,3 +377,122 @@ void StateMachineTest::VtParameterSubspanTest()
         VERIFY_IS_FALSE(subspan.at(0).has_value());
     }
 }
+
+void StateMachineTest::CsiParametersSplitAtEveryPosition()
+{
+    auto enginePtr{ std::make_unique<TestStateMachineEngine>() };
+    // this dance is required because StateMachine presumes to take ownership of its engine.
+    auto& engine{ *enginePtr.get() };
+    StateMachine machine{ std::move(enginePtr) };
+
+    // Parameters are consumed in bulk by the state machine. No matter where
+    // the sequence is broken up, the result must be the same.
+    const std::wstring_view sequence{ L"\x1b[38;2;255:1:2;;99999;0m" };
+    const std::vector<size_t> expectedParams{ 38u, 2u, 255u, 0u, 65535u, 0u };
+
+    for (size_t split = 0; split <= sequence.size(); ++split)
+    {
+        engine.ResetTestState();
+        machine.ProcessString(sequence.substr(0, split));
+        machine.ProcessString(sequence.substr(split));
+
+        VERIFY_ARE_EQUAL(VTID("m"), engine.csiId);
+        VERIFY_ARE_EQUAL(expectedParams, engine.csiParams);
+        VERIFY_ARE_EQUAL(L"", engine.printed);
+    }
+}
+
+void StateMachineTest::SgrParsingPerformance()
+{
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+    END_TEST_METHOD_PROPERTIES()
+
+    StateMachine machine{ std::make_unique<TestStateMachineEngine>() };
+
+    // Approximates the redraw of an SGR-heavy TUI like htop: A colored cell at a time.
+    std::wstring frame;
+    constexpr size_t sequencesPerFrame = 10000;
+    for (size_t i = 0; i < sequencesPerFrame; ++i)
+    {
+        fmt::format_to(std::back_inserter(frame), FMT_COMPILE(L"\x1b[0;1;38;2;{};{};{};48;5;{}mx"), i & 0xff, (i >> 8) & 0xff, (i >> 4) & 0xff, i % 256);
+    }
+
+    constexpr size_t frames = 100;
+    const auto beg = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < frames; ++i)
+    {
+        machine.ProcessString(frame);
+    }
+
+    const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - beg).count();
+    const auto sequencesPerSecond = static_cast<double>(frames * sequencesPerFrame) / elapsed;
+    Log::Comment(NoThrowString().Format(L"%zu sequences in %.3f s: %.0f sequences/s", frames * sequencesPerFrame, elapsed, sequencesPerSecond));
+}
+
+void StateMachineTest::ParsingThroughputPerClass()
+{
+    BEGIN_TEST_METHOD_PROPERTIES()
+        TEST_METHOD_PROPERTY(L"IsPerfTest", L"true")
+        TEST_METHOD_PROPERTY(L"Data:sequenceClass", L"{ 0, 1, 2, 3, 4 }")
+    END_TEST_METHOD_PROPERTIES()
+
+    int sequenceClass;
+    VERIFY_SUCCEEDED(TestData::TryGetValue(L"sequenceClass", sequenceClass));
+
+    auto engineInstance = std::make_unique<TestStateMachineEngine>();
+    auto& engine = *engineInstance;
+    StateMachine machine{ std::move(engineInstance) };
+
+    // Each class exercises a different loop in the StateMachine. The payloads are
+    // roughly 1MB each so that the per-call overhead of ProcessString() doesn't matter.
+    const wchar_t* name = nullptr;
+    std::wstring_view unit;
+    switch (sequenceClass)
+    {
+    case 0:
+        name = L"printable";
+        unit = L"Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore.";
+        break;
+    case 1:
+        name = L"CSI";
+        unit = L"\x1b[12;34H\x1b[2K\x1b[?25l\x1b[38;5;208m\x1b[3A\x1b[m";
+        break;
+    case 2:
+        name = L"OSC";
+        unit = L"\x1b]0;user@host: ~/src/terminal\x1b\\\x1b]8;;https://example.com\x07link\x1b]8;;\x07";
+        break;
+    case 3:
+        name = L"DCS";
+        unit = L"\x1bP1$r0;1;38;2;1;2;3m\x1b\\\x1bP$qm\x1b\\";
+        break;
+    default:
+        name = L"controls";
+        unit = L"a\r\nb\tc\bd\r\ne\x1b" L"7f\x1b" L"8";
+        break;
+    }
+
+    std::wstring frame;
+    while (frame.size() < 1024 * 1024)
+    {
+        frame.append(unit);
+    }
+
+    constexpr size_t frames = 20;
+    std::chrono::steady_clock::duration elapsed{};
+
+    for (size_t i = 0; i < frames; ++i)
+    {
+        const auto beg = std::chrono::steady_clock::now();
+        machine.ProcessString(frame);
+        elapsed += std::chrono::steady_clock::now() - beg;
+
+        // The test engine accumulates what it was given, so don't let that grow forever.
+        engine.ResetTestState();
+    }
+
+    const auto bytes = static_cast<double>(frames * frame.size() * sizeof(wchar_t));
+    const auto nsPerByte = std::chrono::duration<double, std::nano>(elapsed).count() / bytes;
+    Log::Comment(NoThrowString().Format(L"%s: %.3f ns/byte", name, nsPerByte));
+}
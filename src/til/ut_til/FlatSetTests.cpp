@@ -62,4 +62,40 @@ class FlatSetTests
         VERIFY_ARE_EQUAL(entry1, entry2);
         VERIFY_ARE_EQUAL(123u, entry2->value);
     }
+
+    TEST_METHOD(Erase)
+    {
+        til::linear_flat_set<Data, DataHashTrait> set;
+
+        // Enough items to cause collisions and a few resizes.
+        for (size_t i = 0; i < 100; ++i)
+        {
+            set.insert(i);
+        }
+        for (size_t i = 0; i < 100; i += 2)
+        {
+            set.erase(set.lookup(i));
+        }
+
+        VERIFY_ARE_EQUAL(50u, set.size());
+
+        for (size_t i = 0; i < 100; ++i)
+        {
+            const auto entry = set.lookup(i);
+            if (i & 1)
+            {
+                VERIFY_IS_NOT_NULL(entry);
+                VERIFY_ARE_EQUAL(i, entry->value);
+            }
+            else
+            {
+                VERIFY_IS_NULL(entry);
+            }
+        }
+
+        // Erased items can be inserted again.
+        const auto [entry, inserted] = set.insert(42);
+        VERIFY_IS_TRUE(inserted);
+        VERIFY_ARE_EQUAL(42u, entry->value);
+    }
 };
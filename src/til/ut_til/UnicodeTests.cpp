@@ -79,4 +79,18 @@ class UnicodeTests
             VERIFY_ARE_EQUAL(end, it);
         }
     }
+
+    TEST_METHOD(is_standalone_wide)
+    {
+        for (const auto ch : { L'\x3041', L'\x30A2', L'\x4E00', L'\x9FFF', L'\xAC00', L'\xF900', L'\xFF21' })
+        {
+            VERIFY_IS_TRUE(til::is_standalone_wide(ch));
+        }
+
+        // ASCII, the (combining) sound marks, the middle dot, the prolonged sound mark, the end of Hangul and halfwidth forms.
+        for (const auto ch : { L'a', L'\x3099', L'\x309B', L'\x30FB', L'\x30FC', L'\xD7A4', L'\xFF61' })
+        {
+            VERIFY_IS_FALSE(til::is_standalone_wide(ch));
+        }
+    }
 };
@@ -17,6 +17,7 @@ class Utf8Utf16ConvertTests
     TEST_METHOD(TestU8ToU16Partials);
     TEST_METHOD(TestU16ToU8Partials);
     TEST_METHOD(TestU8ToU16OneByOne);
+    TEST_METHOD(TestAsciiFastLane);
 };
 
 void Utf8Utf16ConvertTests::TestU8ToU16()
@@ -191,3 +192,49 @@ void Utf8Utf16ConvertTests::TestU8ToU16OneByOne()
     VERIFY_SUCCEEDED(til::u8u16(u8String1_4, u16Out1, state));
     VERIFY_ARE_EQUAL(u16StringComp1, u16Out1);
 }
+
+void Utf8Utf16ConvertTests::TestAsciiFastLane()
+{
+    // ASCII runs are converted without the help of MultiByteToWideChar/WideCharToMultiByte,
+    // unless they're short gaps between non-ASCII characters (see til::details::min_ascii_run).
+    // The results must nonetheless be identical to that of the platform functions,
+    // no matter how long the ASCII runs are, or where the non-ASCII characters are.
+    // The invalid UTF-8 sequences ensure that the replacement behavior is the same as well.
+    static constexpr std::string_view fragments[]{
+        "\xC3\xB6",
+        "\xE2\x82\xAC",
+        "\xF0\xA4\xBD\x9C",
+        "\xE2\x82",
+        "\x80",
+    };
+
+    for (size_t asciiLen = 0; asciiLen < 40; ++asciiLen)
+    {
+        for (const auto fragment : fragments)
+        {
+            std::string u8String(asciiLen, 'a');
+            u8String.append(fragment);
+            u8String.append(asciiLen, 'b');
+            u8String.append(fragment);
+            u8String.append(asciiLen, 'c');
+
+            std::wstring expected16(u8String.size(), L'\0');
+            expected16.resize(MultiByteToWideChar(CP_UTF8, 0, u8String.data(), gsl::narrow_cast<int>(u8String.size()), expected16.data(), gsl::narrow_cast<int>(expected16.size())));
+
+            std::wstring u16Out;
+            VERIFY_SUCCEEDED(til::u8u16(u8String, u16Out));
+            VERIFY_ARE_EQUAL(expected16, u16Out);
+
+            til::u8state state{};
+            VERIFY_SUCCEEDED(til::u8u16(u8String, u16Out, state));
+            VERIFY_ARE_EQUAL(expected16, u16Out);
+
+            std::string expected8(expected16.size() * 3, '\0');
+            expected8.resize(WideCharToMultiByte(CP_UTF8, 0, expected16.data(), gsl::narrow_cast<int>(expected16.size()), expected8.data(), gsl::narrow_cast<int>(expected8.size()), nullptr, nullptr));
+
+            std::string u8Out;
+            VERIFY_SUCCEEDED(til::u16u8(expected16, u8Out));
+            VERIFY_ARE_EQUAL(expected8, u8Out);
+        }
+    }
+}
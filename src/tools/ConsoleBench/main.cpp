@@ -8,10 +8,12 @@
 #include "utils.h"
 
 #define ENABLE_TEST_OUTPUT_WRITE 1
+#define ENABLE_TEST_OUTPUT_VT 1
 #define ENABLE_TEST_OUTPUT_SCROLL 1
 #define ENABLE_TEST_OUTPUT_FILL 1
 #define ENABLE_TEST_OUTPUT_READ 1
 #define ENABLE_TEST_INPUT 1
+#define ENABLE_TEST_HANDLES 1
 #define ENABLE_TEST_CLIPBOARD 1
 
 using Measurements = std::span<int32_t>;
@@ -31,8 +33,11 @@ struct BenchmarkContext
     mem::Arena& arena;
     std::string_view utf8_4Ki;
     std::string_view utf8_128Ki;
+    std::string_view ascii_128Ki;
     std::wstring_view utf16_4Ki;
     std::wstring_view utf16_128Ki;
+    std::wstring_view cjk_128Ki;
+    std::string_view sgr_128Ki;
     std::span<WORD> attr_4Ki;
     std::span<CHAR_INFO> char_4Ki;
     std::span<INPUT_RECORD> input_4Ki;
@@ -99,6 +104,18 @@ static constexpr Benchmark s_benchmarks[] = {
             }
         },
     },
+    Benchmark{
+        .title = "WriteConsoleA 128Ki ASCII",
+        .exec = [](BenchmarkContext& ctx) {
+            while (ctx.wants_more())
+            {
+                ctx.mark_beg();
+                const auto res = WriteConsoleA(ctx.output, ctx.ascii_128Ki.data(), static_cast<DWORD>(ctx.ascii_128Ki.size()), nullptr, nullptr);
+                ctx.mark_end();
+                debugAssert(res == TRUE);
+            }
+        },
+    },
     Benchmark{
         .title = "WriteConsoleW 128Ki",
         .exec = [](BenchmarkContext& ctx) {
@@ -160,6 +177,50 @@ static constexpr Benchmark s_benchmarks[] = {
         },
     },
 #endif
+#if ENABLE_TEST_OUTPUT_VT
+    Benchmark{
+        .title = "WriteConsoleW 128Ki CJK",
+        .exec = [](BenchmarkContext& ctx) {
+            while (ctx.wants_more())
+            {
+                ctx.mark_beg();
+                const auto res = WriteConsoleW(ctx.output, ctx.cjk_128Ki.data(), static_cast<DWORD>(ctx.cjk_128Ki.size()), nullptr, nullptr);
+                ctx.mark_end();
+                debugAssert(res == TRUE);
+            }
+        },
+    },
+    Benchmark{
+        .title = "VT SGR 128Ki",
+        .exec = [](BenchmarkContext& ctx) {
+            while (ctx.wants_more())
+            {
+                ctx.mark_beg();
+                const auto res = WriteConsoleA(ctx.output, ctx.sgr_128Ki.data(), static_cast<DWORD>(ctx.sgr_128Ki.size()), nullptr, nullptr);
+                ctx.mark_end();
+                debugAssert(res == TRUE);
+            }
+        },
+    },
+    Benchmark{
+        .title = "VT DECSTBM scroll 128Ki",
+        .exec = [](BenchmarkContext& ctx) {
+            // Scrolling within margins can't use the circular buffer and has to move rows around.
+            // DECSTBM moves the cursor to the top of the screen, which is above the margins. That's fine:
+            // The text will wrap down into the margins and then scroll within them. The runner resets
+            // the margins with RIS (\033c) between runs.
+            WriteConsoleW(ctx.output, L"\033[5;25r", 7, nullptr, nullptr);
+
+            while (ctx.wants_more())
+            {
+                ctx.mark_beg();
+                const auto res = WriteConsoleA(ctx.output, ctx.ascii_128Ki.data(), static_cast<DWORD>(ctx.ascii_128Ki.size()), nullptr, nullptr);
+                ctx.mark_end();
+                debugAssert(res == TRUE);
+            }
+        },
+    },
+#endif
 #if ENABLE_TEST_OUTPUT_SCROLL
     Benchmark{
         .title = "ScrollConsoleScreenBufferW 4Ki",
@@ -404,6 +465,90 @@ static constexpr Benchmark s_benchmarks[] = {
             }
         },
     },
+    Benchmark{
+        .title = "Keystroke echo latency",
+        .exec = [](BenchmarkContext& ctx) {
+            // This measures the time from a key press arriving in the input buffer until a cooked read has
+            // echoed it into the output buffer and returned it, the way a shell prompt would see it.
+            // The time it takes for the echo to show up on screen isn't part of this.
+            static constexpr INPUT_RECORD keys[] = {
+                INPUT_RECORD{
+                    .EventType = KEY_EVENT,
+                    .Event = {
+                        .KeyEvent = {
+                            .bKeyDown = TRUE,
+                            .wRepeatCount = 1,
+                            .wVirtualKeyCode = 'A',
+                            .wVirtualScanCode = 0,
+                            .uChar = 'A',
+                            .dwControlKeyState = 0,
+                        },
+                    },
+                },
+                INPUT_RECORD{
+                    .EventType = KEY_EVENT,
+                    .Event = {
+                        .KeyEvent = {
+                            .bKeyDown = TRUE,
+                            .wRepeatCount = 1,
+                            .wVirtualKeyCode = VK_RETURN,
+                            .wVirtualScanCode = 0,
+                            .uChar = '\r',
+                            .dwControlKeyState = 0,
+                        },
+                    },
+                },
+            };
+            wchar_t buf[8];
+            DWORD mode, written, read;
+
+            GetConsoleMode(ctx.input, &mode);
+            SetConsoleMode(ctx.input, ENABLE_PROCESSED_INPUT | ENABLE_LINE_INPUT | ENABLE_ECHO_INPUT);
+            FlushConsoleInputBuffer(ctx.input);
+
+            while (ctx.wants_more())
+            {
+                ctx.mark_beg();
+                WriteConsoleInputW(ctx.input, &keys[0], _countof(keys), &written);
+                ReadConsoleW(ctx.input, &buf[0], _countof(buf), &read, nullptr);
+                ctx.mark_end();
+                debugAssert(read == 3);
+            }
+
+            SetConsoleMode(ctx.input, mode);
+        },
+    },
+#endif
+#if ENABLE_TEST_HANDLES
+    Benchmark{
+        .title = "CreateFile CONOUT$ + CloseHandle",
+        .exec = [](BenchmarkContext& ctx) {
+            while (ctx.wants_more())
+            {
+                ctx.mark_beg();
+                const auto handle = CreateFileW(L"CONOUT$", GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, 0, nullptr);
+                const auto res = CloseHandle(handle);
+                ctx.mark_end();
+                debugAssert(handle != INVALID_HANDLE_VALUE && res == TRUE);
+            }
+        },
+    },
+    Benchmark{
+        .title = "DuplicateHandle output + CloseHandle",
+        .exec = [](BenchmarkContext& ctx) {
+            const auto process = GetCurrentProcess();
+
+            while (ctx.wants_more())
+            {
+                HANDLE handle = nullptr;
+                ctx.mark_beg();
+                const auto res1 = DuplicateHandle(process, ctx.output, process, &handle, 0, FALSE, DUPLICATE_SAME_ACCESS);
+                const auto res2 = CloseHandle(handle);
+                ctx.mark_end();
+                debugAssert(res1 == TRUE && res2 == TRUE);
+            }
+        },
+    },
 #endif
 #if ENABLE_TEST_CLIPBOARD
     Benchmark{
@@ -447,8 +592,15 @@ static constexpr size_t s_samples_max = 1000;
 // 128 characters and 124 columns.
 static constexpr std::string_view s_payload_utf8{ "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna alΑΒΓΔΕ" };
 // 128 characters and 128 columns.
+static constexpr std::string_view s_payload_ascii{ "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua.ABCDE" };
+// 128 characters and 128 columns.
 static constexpr std::wstring_view s_payload_utf16{ L"Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua.ΑΒΓΔΕ" };
 
+// 64 characters and 128 columns.
+static constexpr std::wstring_view s_payload_cjk{ L"吾輩は猫である。名前はまだ無い。どこで生れたかとんと見当がつかぬ。何でも薄暗いじめじめした所でニャーニャー泣いていた事だけは記憶" };
+// Colored words with a mix of 16-color, 256-color and RGB SGR sequences, as emitted by typical TUIs.
+static constexpr std::string_view s_payload_sgr{ "\x1b[31mLorem \x1b[32mipsum \x1b[1;33mdolor \x1b[22;34msit \x1b[38;5;208mamet, \x1b[38;2;255;128;0mconsectetur \x1b[48;5;17madipiscing\x1b[m elit " };
+
 static constexpr WORD s_payload_attr = FOREGROUND_BLUE | FOREGROUND_GREEN | FOREGROUND_RED;
 static constexpr CHAR_INFO s_payload_char{
     .Char = { .UnicodeChar = L'A' },
@@ -472,6 +624,7 @@ static bool print_warning();
 static AccumulatedResults* prepare_results(mem::Arena& arena, std::span<const wchar_t*> paths);
 static std::span<Measurements> run_benchmarks_for_path(mem::Arena& arena, const wchar_t* path);
 static void generate_html(mem::Arena& arena, const AccumulatedResults* results);
+static void generate_json(mem::Arena& arena, const AccumulatedResults* results);
 
 int wmain(int argc, const wchar_t* argv[])
 try
@@ -522,6 +675,7 @@ try
     }
 
     generate_html(scratch.arena, results);
+    generate_json(scratch.arena, results);
     return 0;
 }
 catch (const wil::ResultException& e)
@@ -538,7 +692,7 @@ catch (...)
 static bool print_warning()
 {
     mem::print_literal(
-        "This will overwrite any existing measurements.html in your current working directory.\r\n"
+        "This will overwrite any existing measurements.html and measurements.json in your current working directory.\r\n"
         "\r\n"
         "For best test results:\r\n"
         "* Make sure your system is fully idle and your CPU cool\r\n"
@@ -680,8 +834,11 @@ static std::span<Measurements> run_benchmarks_for_path(mem::Arena& arena, const
         .arena = scratch.arena,
         .utf8_4Ki = mem::repeat(scratch.arena, s_payload_utf8, 4 * 1024 / s_payload_utf8.size()),
         .utf8_128Ki = mem::repeat(scratch.arena, s_payload_utf8, 128 * 1024 / s_payload_utf8.size()),
+        .ascii_128Ki = mem::repeat(scratch.arena, s_payload_ascii, 128 * 1024 / s_payload_ascii.size()),
         .utf16_4Ki = mem::repeat(scratch.arena, s_payload_utf16, 4 * 1024 / s_payload_utf16.size()),
         .utf16_128Ki = mem::repeat(scratch.arena, s_payload_utf16, 128 * 1024 / s_payload_utf16.size()),
+        .cjk_128Ki = mem::repeat(scratch.arena, s_payload_cjk, 128 * 1024 / s_payload_cjk.size()),
+        .sgr_128Ki = mem::repeat(scratch.arena, s_payload_sgr, 128 * 1024 / s_payload_sgr.size()),
         .attr_4Ki = mem::repeat(scratch.arena, s_payload_attr, 4 * 1024),
         .char_4Ki = mem::repeat(scratch.arena, s_payload_char, 4 * 1024),
         .input_4Ki = mem::repeat(scratch.arena, s_payload_record, 4 * 1024),
@@ -864,6 +1021,76 @@ static void generate_html(mem::Arena& arena, const AccumulatedResults* results)
 )");
 }
 
+// Writes the summary statistics of each benchmark in a machine-readable format,
+// so that results can be compared against a baseline from a previous run.
+static void generate_json(mem::Arena& arena, const AccumulatedResults* results)
+{
+    const auto scratch = mem::get_scratch_arena(arena);
+
+    const wil::unique_hfile file{ THROW_LAST_ERROR_IF_NULL(CreateFileW(L"measurements.json", GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_DELETE, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr)) };
+    const auto sec_per_tick = 1.0 / query_perf_freq();
+    BufferedWriter writer{ file.get(), scratch.arena.push_uninitialized_span<char>(64 * 1024) };
+
+    const auto write_seconds = [&](std::string_view key, double ticks) {
+        char buffer[32];
+        const auto res = std::to_chars(&buffer[0], &buffer[32], ticks * sec_per_tick, std::chars_format::scientific, 3);
+        writer.write(key);
+        writer.write({ &buffer[0], res.ptr });
+    };
+
+    writer.write("{\"benchmarks\":[");
+
+    for (size_t bench_idx = 0; bench_idx < s_benchmarks_count; ++bench_idx)
+    {
+        const auto& bench = s_benchmarks[bench_idx];
+
+        writer.write(bench_idx ? ",{\"title\":\"" : "{\"title\":\"");
+        writer.write(bench.title);
+        writer.write("\",\"results\":[");
+
+        for (size_t trace_idx = 0; trace_idx < results->trace_count; ++trace_idx)
+        {
+            writer.write(trace_idx ? ",{\"trace\":\"" : "{\"trace\":\"");
+            writer.write(results->trace_names[trace_idx]);
+            writer.write("\"");
+
+            const auto measurements = results->measurments[trace_idx][bench_idx];
+            if (!measurements.empty())
+            {
+                std::sort(measurements.begin(), measurements.end());
+
+                const auto percentile = [&](size_t permille) {
+                    return static_cast<double>(measurements[(measurements.size() - 1) * permille / 1000]);
+                };
+
+                int64_t sum = 0;
+                for (const auto m : measurements)
+                {
+                    sum += m;
+                }
+
+                char buffer[32];
+                const auto res = std::to_chars(&buffer[0], &buffer[32], measurements.size());
+                writer.write(",\"samples\":");
+                writer.write({ &buffer[0], res.ptr });
+
+                write_seconds(",\"min\":", percentile(0));
+                write_seconds(",\"p50\":", percentile(500));
+                write_seconds(",\"p90\":", percentile(900));
+                write_seconds(",\"p99\":", percentile(990));
+                write_seconds(",\"max\":", percentile(1000));
+                write_seconds(",\"mean\":", static_cast<double>(sum) / measurements.size());
+            }
+
+            writer.write("}");
+        }
+
+        writer.write("]}");
+    }
+
+    writer.write("]}\n");
+}
+
 bool BenchmarkContext::wants_more() const
 {
     return m_measurements_off < s_samples_min || (m_measurements_off < m_measurements.size() && m_time < m_time_limit);
@@ -278,6 +278,19 @@ int main()
         clear();
     }
 
+    {
+        // AtlasEngine maps printable ASCII separately from the rest of the text. The characters
+        // around that boundary must still be shaped together, or ligatures and kerning break.
+        printUTF16(
+            L"\x1b[3;5HLigatures across font lookups - use a font with ligatures like Cascadia Code"
+            L"\x1b[5;5HASCII only:      a=>e a!=e a->e"
+            L"\x1b[6;5HFollowed by \u00e9: a=>\u00e9 a!=\u00e9 a->\u00e9"
+            L"\x1b[7;5HFollowed by \u0301: a=>e\u0301 a!=e\u0301 a->e\u0301");
+
+        wait();
+        clear();
+    }
+
     {
         defer
         {
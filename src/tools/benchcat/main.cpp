@@ -426,6 +426,7 @@ int __stdcall main() noexcept
     const wchar_t* path = nullptr;
     uint32_t chunk_size = 128 * 1024;
     uint32_t repeat = 1;
+    uint32_t pace = 0;
     VtMode vt = VtMode::Off;
     uint64_t seed = 0;
     bool has_seed = false;
@@ -445,6 +446,10 @@ int __stdcall main() noexcept
             {
                 repeat = parse_number_with_suffix(suffix);
             }
+            else if (const auto suffix = split_prefix(argv[i], L"-p"))
+            {
+                pace = parse_number_with_suffix(suffix);
+            }
             else if (const auto suffix = split_prefix(argv[i], L"-v"))
             {
                 vt = VtMode::On;
@@ -486,6 +491,7 @@ int __stdcall main() noexcept
             "  -vc       print colorized\r\n"
             "  -c{d}{u}  chunk size, defaults to 128Ki\r\n"
             "  -r{d}{u}  repeats, defaults to 1\r\n"
+            "  -p{d}{u}  pace the output to the given B/s\r\n"
             "  -s{d}     RNG seed\r\n"
             "{d} are base-10 digits\r\n"
             "{u} are suffix units k, Ki, M, Mi, G, Gi\r\n");
@@ -635,13 +641,29 @@ int __stdcall main() noexcept
     QueryPerformanceFrequency(&frequency);
     QueryPerformanceCounter(&beg);
 
+    // The number of bytes written so far. Used for pacing.
+    LONGLONG total_written = 0;
+
     for (size_t iteration = 0; iteration < repeat; ++iteration)
     {
         auto write_data = stdout_data;
         DWORD written = 0;
 
-        for (auto remaining = stdout_size; remaining != 0; remaining -= written, write_data += written)
+        for (auto remaining = stdout_size; remaining != 0; remaining -= written, write_data += written, total_written += written)
         {
+            if (pace)
+            {
+                // Wait until the next chunk is due. If the console can't keep up, we're never ahead
+                // of schedule, and the achieved throughput will end up below the target.
+                LARGE_INTEGER now;
+                QueryPerformanceCounter(&now);
+                const auto due = beg.QuadPart + total_written * frequency.QuadPart / pace;
+                if (due > now.QuadPart)
+                {
+                    Sleep(static_cast<DWORD>((due - now.QuadPart) * 1000 / frequency.QuadPart));
+                }
+            }
+
             written = static_cast<DWORD>(min<size_t>(remaining, chunk_size));
             if (!WriteFile(stdout, write_data, written, &written, nullptr))
             {
@@ -675,6 +697,15 @@ int __stdcall main() noexcept
         clean_exit(1);
     }
 
+    char pace_status[64];
+    auto pace_status_length = 0;
+    if (pace)
+    {
+        const auto target = format_size(pace);
+        pace_status_length = format(&pace_status[0], sizeof(pace_status), " (target " FORMAT_RESULT_FMT "B/s)", FORMAT_RESULT_ARGS(target));
+        pace_status_length = max(pace_status_length, 0);
+    }
+
     char buffer[256];
     char* buffer_end = &buffer[0];
 
@@ -685,6 +716,7 @@ int __stdcall main() noexcept
     }
     buffer_end = buffer_append_string(buffer_end, "\r\n");
     buffer_end = buffer_append_long(buffer_end, &status[0], static_cast<size_t>(status_length));
+    buffer_end = buffer_append_long(buffer_end, &pace_status[0], static_cast<size_t>(pace_status_length));
     buffer_end = buffer_append_string(buffer_end, "\r\n");
 
     WriteFile(g_stderr, &buffer[0], static_cast<DWORD>(buffer_end - &buffer[0]), nullptr, nullptr);
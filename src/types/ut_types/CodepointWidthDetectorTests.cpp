@@ -1331,6 +1331,34 @@ class CodepointWidthDetectorTests
         VERIFY_ARE_EQUAL(expectedWidths, actualWidths);
     }
 
+    TEST_METHOD(RepeatedGraphemes)
+    {
+        // Repeated clusters must measure the same every time, while the third one
+        // starts just like them but continues with another ZWJ and must not be cut short.
+        static constexpr std::wstring_view text{ L"\U0001F468\u200D\U0001F469 \U0001F468\u200D\U0001F469 \U0001F468\u200D\U0001F469\u200D\U0001F467 \U0001F468\u200D\U0001F469" };
+
+        auto& cwd = CodepointWidthDetector::Singleton();
+
+        const std::vector<size_t> expectedAdvances{ 5, 1, 5, 1, 8, 1, 5 };
+        const std::vector<int> expectedWidths{ 2, 1, 2, 1, 2, 1, 2 };
+        std::vector<size_t> actualAdvances;
+        std::vector<int> actualWidths;
+
+        for (GraphemeState state;;)
+        {
+            const auto ok = cwd.GraphemeNext(state, text);
+            actualAdvances.emplace_back(state.len);
+            actualWidths.emplace_back(state.width);
+            if (!ok)
+            {
+                break;
+            }
+        }
+
+        VERIFY_ARE_EQUAL(expectedAdvances, actualAdvances);
+        VERIFY_ARE_EQUAL(expectedWidths, actualWidths);
+    }
+
     TEST_METHOD(ChunkedText)
     {
         struct Test
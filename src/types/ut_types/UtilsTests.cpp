@@ -35,6 +35,8 @@ class UtilsTests
 
     TEST_METHOD(TestEvaluateStartingDirectory);
 
+    TEST_METHOD(TestFindActionableControlCharacter);
+
     void _VerifyXTermColorResult(const std::wstring_view wstr, DWORD colorValue);
     void _VerifyXTermColorInvalid(const std::wstring_view wstr);
 };
@@ -618,3 +620,39 @@ void UtilsTests::TestEvaluateStartingDirectory()
         test(L"/dev", cwd, L"/dev");
     }
 }
+
+void UtilsTests::TestFindActionableControlCharacter()
+{
+    // The implementation has an AVX2, SSE2 and scalar path which process 16, 8 and 1 characters
+    // at a time respectively. The strings are long enough and the needle is moved through every
+    // position, so that each of them is tested with match positions in the vectors and the tail.
+    static constexpr wchar_t needles[]{ L'\0', L'\x1b', L'\x1f', L'\x7f', L'\x90', L'\x9f' };
+    static constexpr wchar_t nonNeedles[]{ L' ', L'~', L'\xa0', L'\x100', L'\xffff' };
+
+    for (size_t len = 0; len < 40; ++len)
+    {
+        for (const auto filler : nonNeedles)
+        {
+            const std::wstring haystack(len, filler);
+            const auto beg = haystack.data();
+            VERIFY_ARE_EQUAL(beg + len, FindActionableControlCharacter(beg, len));
+        }
+
+        for (size_t pos = 0; pos < len; ++pos)
+        {
+            for (const auto needle : needles)
+            {
+                std::wstring haystack(len, L'a');
+                haystack[pos] = needle;
+                // A second needle after the first one must not be found.
+                if (pos + 1 < len)
+                {
+                    haystack[len - 1] = L'\n';
+                }
+
+                const auto beg = haystack.data();
+                VERIFY_ARE_EQUAL(beg + pos, FindActionableControlCharacter(beg, len));
+            }
+        }
+    }
+}
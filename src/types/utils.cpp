@@ -4,6 +4,7 @@
 #include "precomp.h"
 #include "inc/utils.hpp"
 
+#include <isa_availability.h>
 #include <til/string.h>
 #include <wil/token_helpers.h>
 
@@ -11,6 +12,8 @@
 
 using namespace Microsoft::Console;
 
+extern "C" int __isa_available;
+
 // Routine Description:
 // - Determines if a character is a valid number character, 0-9.
 // Arguments:
@@ -1157,6 +1160,34 @@ const wchar_t* Utils::FindActionableControlCharacter(const wchar_t* beg, const s
     //   (wch <= 0x1f) | ((wch - 0x7f) <= 0x20)
 #if defined(TIL_SSE_INTRINSICS)
 
+    // Long printable runs are by far the most common input (think `cat` of a build log).
+    // If the CPU supports it we'll look at 16 characters at a time using AVX2. It's the
+    // same algorithm as the SSE2 loop below, which then takes care of the remaining tail.
+    if (__isa_available >= __ISA_AVAILABLE_AVX2)
+    {
+        for (const auto end = beg + (len & ~size_t{ 15 }); it < end; it += 16)
+        {
+            const auto wch = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(it));
+            const auto z = _mm256_setzero_si256();
+
+            auto a = _mm256_subs_epu16(wch, _mm256_set1_epi16(0x1f));
+            auto b = _mm256_subs_epu16(_mm256_add_epi16(wch, _mm256_set1_epi16(static_cast<short>(0xff81))), _mm256_set1_epi16(0x20));
+            a = _mm256_cmpeq_epi16(a, z);
+            b = _mm256_cmpeq_epi16(b, z);
+
+            const auto c = _mm256_or_si256(a, b);
+            const auto mask = static_cast<unsigned long>(_mm256_movemask_epi8(c));
+
+            if (mask)
+            {
+                unsigned long offset;
+                _BitScanForward(&offset, mask);
+                it += offset / 2;
+                return it;
+            }
+        }
+    }
+
     for (const auto end = beg + (len & ~size_t{ 7 }); it < end; it += 8)
     {
         const auto wch = _mm_loadu_si128(reinterpret_cast<const __m128i*>(it));